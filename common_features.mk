@@ -466,6 +466,11 @@ ifeq ($(strip $(ENCODER_ENABLE)), yes)
     OPT_DEFS += -DENCODER_ENABLE
 endif
 
+ifeq ($(strip $(TASK_PROFILE_ENABLE)), yes)
+    OPT_DEFS += -DTASK_PROFILE_ENABLE
+    SRC += $(QUANTUM_DIR)/task_profile.c
+endif
+
 ifeq ($(strip $(VELOCIKEY_ENABLE)), yes)
     OPT_DEFS += -DVELOCIKEY_ENABLE
     SRC += $(QUANTUM_DIR)/velocikey.c
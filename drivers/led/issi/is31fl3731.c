@@ -18,6 +18,7 @@
 #include "is31fl3731.h"
 #include "i2c_master.h"
 #include "wait.h"
+#include <string.h>
 
 // This is a 7-bit address, that gets left-shifted and bit 0
 // set to 0 for write, 1 for read (as per I2C protocol)
@@ -53,6 +54,8 @@
 #    define ISSI_PERSISTENCE 0
 #endif
 
+#include "issi_pwm_span.h"
+
 // Transfer buffer for TWITransmitData()
 uint8_t g_twi_transfer_buffer[20];
 
@@ -67,6 +70,19 @@ bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 uint8_t g_led_control_registers[DRIVER_COUNT][18]             = {{0}};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
 
+#if defined(ISSI_PARTIAL_PWM_WRITES) && !defined(I2C_ASYNC)
+// What was last written to the PWM registers, so that only the registers that changed are sent
+uint8_t g_pwm_shadow[DRIVER_COUNT][144];
+bool    g_pwm_shadow_valid[DRIVER_COUNT] = {false};
+#endif
+
+#ifdef I2C_ASYNC
+// Copy of the PWM registers being sent in the background, starting with the register address.
+// ISSI_PERSISTENCE does not apply to these transfers.
+static uint8_t               g_pwm_transfer_buffer[DRIVER_COUNT][1 + 144];
+static volatile i2c_status_t g_pwm_transfer_status[DRIVER_COUNT];
+#endif
+
 // This is the bit pattern in the LED control registers
 // (for matrix A, add one to register for matrix B)
 //
@@ -121,7 +137,35 @@ void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     }
 }
 
+#if defined(ISSI_PARTIAL_PWM_WRITES) && !defined(I2C_ASYNC)
+static void IS31FL3731_write_changed_pwm_registers(uint8_t addr, uint8_t index) {
+    // assumes bank is already selected
+    uint8_t *pwm_buffer = g_pwm_buffer[index];
+    uint8_t *shadow     = g_pwm_shadow[index];
+    bool     success    = true;
+    if (!g_pwm_shadow_valid[index] || !issi_pwm_spans_are_cheaper(pwm_buffer, shadow, 144, 144, 16)) {
+        success = issi_pwm_write_span(addr, g_twi_transfer_buffer, pwm_buffer, 0x24, 144, 16, 0, 144);
+    } else {
+        uint16_t length;
+        for (uint16_t start = 0; success && (length = issi_pwm_next_span(pwm_buffer, shadow, 144, 144, &start)) > 0; start += length) {
+            success = issi_pwm_write_span(addr, g_twi_transfer_buffer, pwm_buffer, 0x24, 144, 16, start, length);
+        }
+    }
+
+    // after a failure the registers are unknown, send the whole buffer next time
+    if (success) {
+        memcpy(shadow, pwm_buffer, 144);
+    }
+    g_pwm_shadow_valid[index] = success;
+}
+#endif
+
 void IS31FL3731_init(uint8_t addr) {
+#if defined(ISSI_PARTIAL_PWM_WRITES) && !defined(I2C_ASYNC)
+    // the PWM registers are cleared below, see issi_pwm_span.h
+    memset(g_pwm_shadow_valid, 0, sizeof(g_pwm_shadow_valid));
+#endif
+
     // In order to avoid the LEDs being driven with garbage data
     // in the LED driver's PWM registers, first enable software shutdown,
     // then set up the mode and other settings, clear the PWM registers,
@@ -221,8 +265,26 @@ void IS31FL3731_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void IS31FL3731_update_pwm_buffers(uint8_t addr, uint8_t index) {
+#ifdef I2C_ASYNC
+    // The PWM copy is reused, so the previous flush has to be sent first.
+    // If it failed, send the whole page again.
+    i2c_async_wait();
+    if (g_pwm_transfer_status[index] != I2C_STATUS_SUCCESS) {
+        g_pwm_transfer_status[index]        = I2C_STATUS_SUCCESS;
+        g_pwm_buffer_update_required[index] = true;
+    }
+#endif
     if (g_pwm_buffer_update_required[index]) {
+#ifdef I2C_ASYNC
+        // assumes bank is already selected
+        g_pwm_transfer_buffer[index][0] = 0x24;
+        memcpy(&g_pwm_transfer_buffer[index][1], g_pwm_buffer[index], 144);
+        i2c_transmit_async(addr << 1, g_pwm_transfer_buffer[index], sizeof(g_pwm_transfer_buffer[index]), ISSI_TIMEOUT, &g_pwm_transfer_status[index]);
+#elif defined(ISSI_PARTIAL_PWM_WRITES)
+        IS31FL3731_write_changed_pwm_registers(addr, index);
+#else
         IS31FL3731_write_pwm_buffer(addr, g_pwm_buffer[index]);
+#endif
     }
     g_pwm_buffer_update_required[index] = false;
 }
@@ -19,6 +19,7 @@
 #include "is31fl3733.h"
 #include "i2c_master.h"
 #include "wait.h"
+#include <string.h>
 
 // This is a 7-bit address, that gets left-shifted and bit 0
 // set to 0 for write, 1 for read (as per I2C protocol)
@@ -56,6 +57,8 @@
 #    define ISSI_PERSISTENCE 0
 #endif
 
+#include "issi_pwm_span.h"
+
 // Transfer buffer for TWITransmitData()
 uint8_t g_twi_transfer_buffer[20];
 
@@ -71,6 +74,22 @@ bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 uint8_t g_led_control_registers[DRIVER_COUNT][24]             = {0};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
 
+#if defined(ISSI_PARTIAL_PWM_WRITES) && !defined(I2C_ASYNC)
+// What was last written to the PWM registers, so that only the registers that changed are sent
+uint8_t g_pwm_shadow[DRIVER_COUNT][192];
+bool    g_pwm_shadow_valid[DRIVER_COUNT] = {false};
+#endif
+
+#ifdef I2C_ASYNC
+// Copy of the PWM page being sent in the background, starting with the register address.
+// ISSI_PERSISTENCE does not apply to these transfers.
+static uint8_t               g_pwm_transfer_buffer[DRIVER_COUNT][1 + 192];
+static volatile i2c_status_t g_pwm_transfer_status[DRIVER_COUNT];
+
+static const uint8_t g_unlock_command[]  = {ISSI_COMMANDREGISTER_WRITELOCK, 0xC5};
+static const uint8_t g_select_pwm_page[] = {ISSI_COMMANDREGISTER, ISSI_PAGE_PWM};
+#endif
+
 bool IS31FL3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     // If the transaction fails function returns false.
     g_twi_transfer_buffer[0] = reg;
@@ -121,7 +140,36 @@ bool IS31FL3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     return true;
 }
 
+#if defined(ISSI_PARTIAL_PWM_WRITES) && !defined(I2C_ASYNC)
+static bool IS31FL3733_write_changed_pwm_registers(uint8_t addr, uint8_t index) {
+    // Assumes PG1 is already selected.
+    uint8_t *pwm_buffer = g_pwm_buffer[index];
+    uint8_t *shadow     = g_pwm_shadow[index];
+    bool     success    = true;
+    if (!g_pwm_shadow_valid[index] || !issi_pwm_spans_are_cheaper(pwm_buffer, shadow, 192, 192, 16)) {
+        success = issi_pwm_write_span(addr, g_twi_transfer_buffer, pwm_buffer, 0, 192, 16, 0, 192);
+    } else {
+        uint16_t length;
+        for (uint16_t start = 0; success && (length = issi_pwm_next_span(pwm_buffer, shadow, 192, 192, &start)) > 0; start += length) {
+            success = issi_pwm_write_span(addr, g_twi_transfer_buffer, pwm_buffer, 0, 192, 16, start, length);
+        }
+    }
+
+    // After a failure the registers are unknown, send the whole page next time.
+    if (success) {
+        memcpy(shadow, pwm_buffer, 192);
+    }
+    g_pwm_shadow_valid[index] = success;
+    return success;
+}
+#endif
+
 void IS31FL3733_init(uint8_t addr, uint8_t sync) {
+#if defined(ISSI_PARTIAL_PWM_WRITES) && !defined(I2C_ASYNC)
+    // The PWM registers are cleared below, see issi_pwm_span.h.
+    memset(g_pwm_shadow_valid, 0, sizeof(g_pwm_shadow_valid));
+#endif
+
     // In order to avoid the LEDs being driven with garbage data
     // in the LED driver's PWM registers, shutdown is enabled last.
     // Set up the mode and other settings, clear the PWM registers,
@@ -210,6 +258,23 @@ void IS31FL3733_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void IS31FL3733_update_pwm_buffers(uint8_t addr, uint8_t index) {
+#ifdef I2C_ASYNC
+    // The PWM copy is reused, so the previous flush has to be sent first.
+    // If it failed we risk having written dirty PG0,
+    // refresh page 0 just in case.
+    i2c_async_wait();
+    if (g_pwm_transfer_status[index] != I2C_STATUS_SUCCESS) {
+        g_pwm_transfer_status[index]                   = I2C_STATUS_SUCCESS;
+        g_led_control_registers_update_required[index] = true;
+    }
+    if (g_pwm_buffer_update_required[index]) {
+        g_pwm_transfer_buffer[index][0] = 0x00;
+        memcpy(&g_pwm_transfer_buffer[index][1], g_pwm_buffer[index], 192);
+        i2c_transmit_async(addr << 1, g_unlock_command, sizeof(g_unlock_command), ISSI_TIMEOUT, &g_pwm_transfer_status[index]);
+        i2c_transmit_async(addr << 1, g_select_pwm_page, sizeof(g_select_pwm_page), ISSI_TIMEOUT, &g_pwm_transfer_status[index]);
+        i2c_transmit_async(addr << 1, g_pwm_transfer_buffer[index], sizeof(g_pwm_transfer_buffer[index]), ISSI_TIMEOUT, &g_pwm_transfer_status[index]);
+    }
+#else
     if (g_pwm_buffer_update_required[index]) {
         // Firstly we need to unlock the command register and select PG1.
         IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
@@ -217,10 +282,15 @@ void IS31FL3733_update_pwm_buffers(uint8_t addr, uint8_t index) {
 
         // If any of the transactions fail we risk writing dirty PG0,
         // refresh page 0 just in case.
+#    ifdef ISSI_PARTIAL_PWM_WRITES
+        if (!IS31FL3733_write_changed_pwm_registers(addr, index)) {
+#    else
         if (!IS31FL3733_write_pwm_buffer(addr, g_pwm_buffer[index])) {
+#    endif
             g_led_control_registers_update_required[index] = true;
         }
     }
+#endif
     g_pwm_buffer_update_required[index] = false;
 }
 
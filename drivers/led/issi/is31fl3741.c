@@ -63,6 +63,8 @@
 
 #define ISSI_MAX_LEDS 351
 
+#include "issi_pwm_span.h"
+
 // Transfer buffer for TWITransmitData()
 uint8_t g_twi_transfer_buffer[20] = {0xFF};
 
@@ -78,16 +80,24 @@ bool    g_scaling_registers_update_required[DRIVER_COUNT] = {false};
 
 uint8_t g_scaling_registers[DRIVER_COUNT][ISSI_MAX_LEDS];
 
-void IS31FL3741_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
+#ifdef ISSI_PARTIAL_PWM_WRITES
+// What was last written to the PWM registers, so that only the registers that changed are sent
+uint8_t g_pwm_shadow[DRIVER_COUNT][ISSI_MAX_LEDS];
+bool    g_pwm_shadow_valid[DRIVER_COUNT] = {false};
+#endif
+
+bool IS31FL3741_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
+    // returns false if the transaction fails
     g_twi_transfer_buffer[0] = reg;
     g_twi_transfer_buffer[1] = data;
 
 #if ISSI_PERSISTENCE > 0
     for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) == 0) break;
+        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) == 0) return true;
     }
+    return false;
 #else
-    i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT);
+    return i2c_transmit(addr << 1, g_twi_transfer_buffer, 2, ISSI_TIMEOUT) == 0;
 #endif
 }
 
@@ -138,7 +148,50 @@ bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     return true;
 }
 
+#ifdef ISSI_PARTIAL_PWM_WRITES
+// unlock the command register and select the page holding register start of the PWM buffer
+static bool IS31FL3741_select_pwm_page(uint8_t addr, uint16_t start) {
+    if (!IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5)) {
+        return false;
+    }
+    return IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, start < 180 ? ISSI_PAGE_PWM0 : ISSI_PAGE_PWM1);
+}
+
+static bool IS31FL3741_write_changed_pwm_registers(uint8_t addr, uint8_t index) {
+    // PG0 holds registers 0-179 of the buffer and PG1 the rest, spans do not cross from one to the other
+    uint8_t *pwm_buffer = g_pwm_buffer[index];
+    uint8_t *shadow     = g_pwm_shadow[index];
+    bool     success    = true;
+    if (!g_pwm_shadow_valid[index] || !issi_pwm_spans_are_cheaper(pwm_buffer, shadow, ISSI_MAX_LEDS, 180, 18)) {
+        success = IS31FL3741_select_pwm_page(addr, 0) && issi_pwm_write_span(addr, g_twi_transfer_buffer, pwm_buffer, 0, 180, 18, 0, 180);
+        success = success && IS31FL3741_select_pwm_page(addr, 180) && issi_pwm_write_span(addr, g_twi_transfer_buffer, pwm_buffer, 0, 180, 18, 180, ISSI_MAX_LEDS - 180);
+    } else {
+        uint8_t  page = 0xFF;
+        uint16_t length;
+        for (uint16_t start = 0; success && (length = issi_pwm_next_span(pwm_buffer, shadow, ISSI_MAX_LEDS, 180, &start)) > 0; start += length) {
+            if (start / 180 != page) {
+                page    = start / 180;
+                success = IS31FL3741_select_pwm_page(addr, start);
+            }
+            success = success && issi_pwm_write_span(addr, g_twi_transfer_buffer, pwm_buffer, 0, 180, 18, start, length);
+        }
+    }
+
+    // after a failure the registers are unknown, send the whole buffer next time
+    if (success) {
+        memcpy(shadow, pwm_buffer, ISSI_MAX_LEDS);
+    }
+    g_pwm_shadow_valid[index] = success;
+    return success;
+}
+#endif
+
 void IS31FL3741_init(uint8_t addr) {
+#ifdef ISSI_PARTIAL_PWM_WRITES
+    // the PWM registers are cleared below, see issi_pwm_span.h
+    memset(g_pwm_shadow_valid, 0, sizeof(g_pwm_shadow_valid));
+#endif
+
     // In order to avoid the LEDs being driven with garbage data
     // in the LED driver's PWM registers, shutdown is enabled last.
     // Set up the mode and other settings, clear the PWM registers,
@@ -208,7 +261,11 @@ void IS31FL3741_set_led_control_register(uint8_t index, bool red, bool green, bo
 
 void IS31FL3741_update_pwm_buffers(uint8_t addr1, uint8_t addr2) {
     if (g_pwm_buffer_update_required) {
+#ifdef ISSI_PARTIAL_PWM_WRITES
+        IS31FL3741_write_changed_pwm_registers(addr1, 0);
+#else
         IS31FL3741_write_pwm_buffer(addr1, g_pwm_buffer[0]);
+#endif
     }
 
     g_pwm_buffer_update_required = false;
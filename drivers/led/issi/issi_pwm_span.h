@@ -0,0 +1,98 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+Partial PWM writes (ISSI_PARTIAL_PWM_WRITES) shared by the ISSI drivers.
+The driver keeps a shadow of what was last written to the PWM registers, and only sends the spans of
+registers that differ from it. A PWM buffer may cover several register pages of page_size registers,
+spans never cross from one page to the next. Include after ISSI_TIMEOUT and ISSI_PERSISTENCE are defined.
+The init functions clear the PWM registers, and as they only know the address of the driver, they drop the
+shadows of every driver, so the next update sends whole buffers.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "i2c_master.h"
+
+// Changed registers separated by fewer unchanged ones than this are sent in one transfer,
+// as starting a new transfer costs about as much as resending a couple of registers
+#ifndef ISSI_PWM_SPAN_GAP
+#    define ISSI_PWM_SPAN_GAP 3
+#endif
+
+// Finds the next span of changed registers at or after *start, returns its length or 0 when there is none
+static inline uint16_t issi_pwm_next_span(const uint8_t *pwm_buffer, const uint8_t *shadow, uint16_t length, uint16_t page_size, uint16_t *start) {
+    uint16_t first = *start;
+    while (first < length && pwm_buffer[first] == shadow[first]) {
+        first++;
+    }
+    if (first == length) {
+        return 0;
+    }
+
+    uint16_t limit = (first / page_size + 1) * page_size;
+    if (limit > length) {
+        limit = length;
+    }
+    uint16_t end = first + 1;
+    for (uint16_t i = end; i < limit && i < end + ISSI_PWM_SPAN_GAP; i++) {
+        if (pwm_buffer[i] != shadow[i]) {
+            end = i + 1;
+        }
+    }
+    *start = first;
+    return end - first;
+}
+
+// Whether sending only the changed spans is cheaper than sending the whole buffer, in transfers of up to
+// chunk registers. Each transfer costs the register address on top of the data, so the whole buffer wins
+// when the changes are spread over most of it.
+static inline bool issi_pwm_spans_are_cheaper(const uint8_t *pwm_buffer, const uint8_t *shadow, uint16_t length, uint16_t page_size, uint8_t chunk) {
+    uint16_t cost = 0;
+    uint16_t span;
+    for (uint16_t start = 0; (span = issi_pwm_next_span(pwm_buffer, shadow, length, page_size, &start)) > 0; start += span) {
+        cost += span + 2 * ((span + chunk - 1) / chunk);
+    }
+    return cost < length + 2 * ((length + chunk - 1) / chunk);
+}
+
+// Sends registers start to start + length - 1 of pwm_buffer in transfers of up to chunk registers, through
+// transfer_buffer, which has room for the register address and chunk registers. Register n of the buffer is
+// at first_register + n % page_size, on a page that has to be selected already. Returns false on failure.
+static inline bool issi_pwm_write_span(uint8_t addr, uint8_t *transfer_buffer, const uint8_t *pwm_buffer, uint8_t first_register, uint16_t page_size, uint8_t chunk, uint16_t start, uint16_t length) {
+    while (length > 0) {
+        uint8_t count      = length < chunk ? length : chunk;
+        transfer_buffer[0] = first_register + start % page_size;
+        memcpy(transfer_buffer + 1, pwm_buffer + start, count);
+
+        bool success = false;
+#if ISSI_PERSISTENCE > 0
+        for (uint8_t i = 0; i < ISSI_PERSISTENCE && !success; i++) {
+            success = i2c_transmit(addr << 1, transfer_buffer, count + 1, ISSI_TIMEOUT) == 0;
+        }
+#else
+        success = i2c_transmit(addr << 1, transfer_buffer, count + 1, ISSI_TIMEOUT) == 0;
+#endif
+        if (!success) return false;
+
+        start += count;
+        length -= count;
+    }
+    return true;
+}
@@ -166,6 +166,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define OLED_I2C_TIMEOUT 100
 #endif
 
+// Most dirty blocks sent to the display per oled_render() call, as one transfer
+#if !defined(OLED_RENDER_BLOCKS)
+#    define OLED_RENDER_BLOCKS 1
+#endif
+
 #if !defined(OLED_UPDATE_INTERVAL) && defined(SPLIT_KEYBOARD)
 #    define OLED_UPDATE_INTERVAL 50
 #endif
@@ -183,6 +188,14 @@ typedef enum {
     OLED_ROTATION_270 = 3,  // OLED_ROTATION_90 | OLED_ROTATION_180
 } oled_rotation_t;
 
+// How the drawing functions combine their pixels with the buffer
+typedef enum {
+    OLED_DRAW_OFF  = 0,  // turns the pixels off
+    OLED_DRAW_ON   = 1,  // turns the pixels on
+    OLED_DRAW_XOR  = 2,  // inverts the pixels
+    OLED_DRAW_COPY = 3,  // sprites: copies on and off pixels, fills: same as OLED_DRAW_ON
+} oled_draw_mode_t;
+
 // Initialize the oled display, rotating the rendered output based on the define passed in.
 // Returns true if the OLED was initialized successfully
 bool oled_init(oled_rotation_t rotation);
@@ -243,6 +256,20 @@ void oled_write_raw_byte(const char data, uint16_t index);
 // Coordinates start at top-left and go right and down for positive x and y
 void oled_write_pixel(uint8_t x, uint8_t y, bool on);
 
+// Draws a filled rectangle of w by h pixels with its top-left corner at x, y
+// Clipped to the display, whole bytes of a page are written at once
+void oled_fill_rect(int16_t x, int16_t y, uint8_t w, uint8_t h, oled_draw_mode_t mode);
+
+// Draws a horizontal line of w pixels starting at x, y
+void oled_draw_hline(int16_t x, int16_t y, uint8_t w, oled_draw_mode_t mode);
+
+// Draws a vertical line of h pixels starting at x, y
+void oled_draw_vline(int16_t x, int16_t y, uint8_t h, oled_draw_mode_t mode);
+
+// Draws a 1bpp sprite of w by h pixels with its top-left corner at x, y, clipped to the display
+// The sprite uses the layout of the display buffer: (h + 7) / 8 pages of w bytes, bit 0 at the top
+void oled_blit(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *sprite, oled_draw_mode_t mode);
+
 #if defined(__AVR__)
 // Writes a PROGMEM string to the buffer at current cursor position
 // Advances the cursor while writing, inverts the pixels if true
@@ -257,10 +284,15 @@ void oled_write_ln_P(const char *data, bool invert);
 
 // Writes a PROGMEM string to the buffer at current cursor position
 void oled_write_raw_P(const char *data, uint16_t size);
+
+// Draws a PROGMEM 1bpp sprite, see oled_blit
+// Remapped to call 'void oled_blit(...);' on ARM
+void oled_blit_P(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *sprite, oled_draw_mode_t mode);
 #else
 #    define oled_write_P(data, invert) oled_write(data, invert)
 #    define oled_write_ln_P(data, invert) oled_write(data, invert)
 #    define oled_write_raw_P(data, size) oled_write_raw(data, size)
+#    define oled_blit_P(x, y, w, h, sprite, mode) oled_blit(x, y, w, h, sprite, mode)
 #endif  // defined(__AVR__)
 
 // Can be used to manually turn on the screen if it is off
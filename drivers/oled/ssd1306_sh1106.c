@@ -240,10 +240,21 @@ void oled_clear(void) {
     oled_dirty  = OLED_ALL_BLOCKS_MASK;
 }
 
-static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
+// Runs of dirty blocks are only sent as one transfer if the display addressing can take them
+// in one go: whole blocks per page, or whole columns of 8 pixels in 90 degree rendering
+#define OLED_BLOCKS_FILL_PAGE (OLED_BLOCK_SIZE <= OLED_DISPLAY_WIDTH && OLED_DISPLAY_WIDTH % OLED_BLOCK_SIZE == 0)
+#define OLED_BLOCKS_PER_PAGE (OLED_BLOCKS_FILL_PAGE ? OLED_DISPLAY_WIDTH / OLED_BLOCK_SIZE : 1)
+#define OLED_RENDER_BLOCKS_0 (OLED_BLOCKS_FILL_PAGE ? OLED_RENDER_BLOCKS : 1)
+#define OLED_RENDER_BLOCKS_90 ((OLED_BLOCK_SIZE % OLED_DISPLAY_HEIGHT == 0 && OLED_IC != OLED_IC_SH1106) ? OLED_RENDER_BLOCKS : 1)
+// Bytes of each page taken by a block in 90 degree rendering
+#define OLED_BLOCK_WIDTH_90 ((OLED_BLOCK_SIZE >= OLED_DISPLAY_HEIGHT) ? OLED_BLOCK_SIZE / OLED_DISPLAY_HEIGHT * 8 : 8)
+
+static void calc_bounds(uint8_t update_start, uint8_t update_count, uint8_t *cmd_array) {
     // Calculate commands to set memory addressing bounds.
-    uint8_t start_page   = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH;
-    uint8_t start_column = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_WIDTH;
+    uint16_t start        = OLED_BLOCK_SIZE * update_start;
+    uint16_t size         = OLED_BLOCK_SIZE * update_count;
+    uint8_t  start_page   = start / OLED_DISPLAY_WIDTH;
+    uint8_t  start_column = start % OLED_DISPLAY_WIDTH;
 #if (OLED_IC == OLED_IC_SH1106)
     // Commands for Page Addressing Mode. Sets starting page and column; has no end bound.
     // Column value must be split into high and low nybble and sent as two commands.
@@ -255,61 +266,163 @@ static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
     cmd_array[5] = NOP;
 #else
     // Commands for use in Horizontal Addressing mode.
-    cmd_array[1] = start_column;
-    cmd_array[4] = start_page;
-    cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + cmd_array[1];
-    cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1;
+    if (start_column + size <= OLED_DISPLAY_WIDTH) {
+        // Within a page
+        cmd_array[1] = start_column;
+        cmd_array[2] = start_column + size - 1;
+        cmd_array[4] = start_page;
+        cmd_array[5] = start_page;
+    } else {
+        // Whole pages from the first column, the last one may be partial
+        cmd_array[1] = start_column;
+        cmd_array[2] = OLED_DISPLAY_WIDTH - 1;
+        cmd_array[4] = start_page;
+        cmd_array[5] = (start + size - 1) / OLED_DISPLAY_WIDTH;
+    }
 #endif
 }
 
-static void calc_bounds_90(uint8_t update_start, uint8_t *cmd_array) {
+static void calc_bounds_90(uint8_t update_start, uint8_t update_count, uint8_t *cmd_array) {
     cmd_array[1] = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_HEIGHT * 8;
     cmd_array[4] = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_HEIGHT;
-    cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8 - 1 + cmd_array[1];
-    ;
+    cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8 * update_count - 1 + cmd_array[1];
     cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) % OLED_DISPLAY_HEIGHT / 8;
 }
 
-uint8_t crot(uint8_t a, int8_t n) {
-    const uint8_t mask = 0x7;
-    n &= mask;
-    return a << n | a >> (-n & mask);
-}
-
+// Transposes an 8x8 tile of pixels: bit i of src[j] becomes bit 7 - j of dest[i].
+// Swaps 1x1, 2x2 and then 4x4 bit blocks across the diagonal, a few shifts and masks
+// on two 32 bit words instead of a loop over all 64 bits.
 static void rotate_90(const uint8_t *src, uint8_t *dest) {
-    for (uint8_t i = 0, shift = 7; i < 8; ++i, --shift) {
-        uint8_t selector = (1 << i);
-        for (uint8_t j = 0; j < 8; ++j) {
-            dest[i] |= crot(src[j] & selector, shift - (int8_t)j);
+    uint32_t x = ((uint32_t)src[0] << 24) | ((uint32_t)src[1] << 16) | ((uint16_t)src[2] << 8) | src[3];
+    uint32_t y = ((uint32_t)src[4] << 24) | ((uint32_t)src[5] << 16) | ((uint16_t)src[6] << 8) | src[7];
+    uint32_t t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AA;
+    x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;
+    y = y ^ t ^ (t << 7);
+
+    t = (x ^ (x >> 14)) & 0x0000CCCC;
+    x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC;
+    y = y ^ t ^ (t << 14);
+
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    x = t;
+
+    dest[0] = y;
+    dest[1] = y >> 8;
+    dest[2] = y >> 16;
+    dest[3] = y >> 24;
+    dest[4] = x;
+    dest[5] = x >> 8;
+    dest[6] = x >> 16;
+    dest[7] = x >> 24;
+}
+
+// Number of dirty blocks from update_start that can be sent as one transfer
+static uint8_t oled_dirty_run(uint8_t update_start) {
+    uint8_t limit;
+    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+        limit = OLED_RENDER_BLOCKS_0;
+        // A transfer that starts mid-page has to end with that page: the column window wraps
+        // back to its first column. SH1106 has no window, and is addressed one page at a time.
+        if (limit > 1) {
+            uint8_t page_offset = update_start % OLED_BLOCKS_PER_PAGE;
+            if (OLED_IC == OLED_IC_SH1106 || page_offset != 0) {
+                uint8_t page_remaining = OLED_BLOCKS_PER_PAGE - page_offset;
+                if (limit > page_remaining) {
+                    limit = page_remaining;
+                }
+            }
         }
+    } else {
+        limit = OLED_RENDER_BLOCKS_90;
+    }
+
+    uint8_t update_count = 1;
+    while (update_count < limit && update_start + update_count < OLED_BLOCK_COUNT && (oled_dirty & ((OLED_BLOCK_TYPE)1 << (update_start + update_count)))) {
+        ++update_count;
     }
+    return update_count;
 }
 
+#ifdef I2C_ASYNC
+static volatile i2c_status_t oled_transfer_status = I2C_STATUS_SUCCESS;
+static OLED_BLOCK_TYPE       oled_transfer_blocks = 0;
+#endif
+
 void oled_render(void) {
     if (!oled_initialized) {
         return;
     }
 
+#ifdef I2C_ASYNC
+    // Wait for the previous transfer to go out, and send its blocks again if it failed
+    if (i2c_async_busy()) {
+        return;
+    }
+    if (oled_transfer_status != I2C_STATUS_SUCCESS) {
+        print("oled_render data failed\n");
+        oled_transfer_status = I2C_STATUS_SUCCESS;
+        oled_dirty |= oled_transfer_blocks;
+    }
+    oled_transfer_blocks = 0;
+#endif
+
     // Do we have work to do?
     oled_dirty &= OLED_ALL_BLOCKS_MASK;
     if (!oled_dirty || oled_scrolling) {
         return;
     }
 
-    // Find first dirty block
+    // Find first dirty block, and the dirty blocks following it that fit in the same transfer
     uint8_t update_start = 0;
     while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
         ++update_start;
     }
+    uint8_t  update_count = oled_dirty_run(update_start);
+    uint16_t update_size  = OLED_BLOCK_SIZE * update_count;
 
     // Set column & page position
     static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
     if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-        calc_bounds(update_start, &display_start[1]);  // Offset from I2C_CMD byte at the start
+        calc_bounds(update_start, update_count, &display_start[1]);  // Offset from I2C_CMD byte at the start
     } else {
-        calc_bounds_90(update_start, &display_start[1]);  // Offset from I2C_CMD byte at the start
+        calc_bounds_90(update_start, update_count, &display_start[1]);  // Offset from I2C_CMD byte at the start
     }
 
+    // Render data, starting with the I2C_DATA byte
+    static uint8_t temp_buffer[1 + OLED_BLOCK_SIZE * OLED_RENDER_BLOCKS];
+    temp_buffer[0] = I2C_DATA;
+
+    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+#ifdef I2C_ASYNC
+        // Copy, as the buffer may change while the transfer is going out
+        memcpy(&temp_buffer[1], &oled_buffer[OLED_BLOCK_SIZE * update_start], update_size);
+#endif
+    } else {
+        // Rotate the render chunks; each block takes OLED_BLOCK_WIDTH_90 bytes of every page
+        const static uint8_t source_map[] = OLED_SOURCE_MAP;
+        const static uint8_t target_map[] = OLED_TARGET_MAP;
+
+        for (uint8_t block = 0; block < update_count; ++block) {
+            for (uint8_t i = 0; i < sizeof(source_map); ++i) {
+                uint16_t target = target_map[i] / OLED_BLOCK_WIDTH_90 * OLED_BLOCK_WIDTH_90 * update_count + target_map[i] % OLED_BLOCK_WIDTH_90 + OLED_BLOCK_WIDTH_90 * block;
+                rotate_90(&oled_buffer[OLED_BLOCK_SIZE * (update_start + block) + source_map[i]], &temp_buffer[1 + target]);
+            }
+        }
+    }
+
+    OLED_BLOCK_TYPE update_blocks = (((OLED_BLOCK_TYPE)1 << (update_count - 1) << 1) - 1) << update_start;
+
+#ifdef I2C_ASYNC
+    // Send column & page position and the render data in the background
+    i2c_transmit_async((OLED_DISPLAY_ADDRESS << 1), display_start, sizeof(display_start), OLED_I2C_TIMEOUT, &oled_transfer_status);
+    i2c_transmit_async((OLED_DISPLAY_ADDRESS << 1), temp_buffer, 1 + update_size, OLED_I2C_TIMEOUT, &oled_transfer_status);
+    oled_transfer_blocks = update_blocks;
+#else
     // Send column & page position
     if (I2C_TRANSMIT(display_start) != I2C_STATUS_SUCCESS) {
         print("oled_render offset command failed\n");
@@ -318,33 +431,24 @@ void oled_render(void) {
 
     if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
         // Send render data chunk as is
-        if (I2C_WRITE_REG(I2C_DATA, &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
+        if (I2C_WRITE_REG(I2C_DATA, &oled_buffer[OLED_BLOCK_SIZE * update_start], update_size) != I2C_STATUS_SUCCESS) {
             print("oled_render data failed\n");
             return;
         }
     } else {
-        // Rotate the render chunks
-        const static uint8_t source_map[] = OLED_SOURCE_MAP;
-        const static uint8_t target_map[] = OLED_TARGET_MAP;
-
-        static uint8_t temp_buffer[OLED_BLOCK_SIZE];
-        memset(temp_buffer, 0, sizeof(temp_buffer));
-        for (uint8_t i = 0; i < sizeof(source_map); ++i) {
-            rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
-        }
-
         // Send render data chunk after rotating
-        if (I2C_WRITE_REG(I2C_DATA, &temp_buffer[0], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
+        if (i2c_transmit((OLED_DISPLAY_ADDRESS << 1), temp_buffer, 1 + update_size, OLED_I2C_TIMEOUT) != I2C_STATUS_SUCCESS) {
             print("oled_render90 data failed\n");
             return;
         }
     }
+#endif
 
     // Turn on display if it is off
     oled_on();
 
     // Clear dirty flag
-    oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+    oled_dirty &= ~update_blocks;
 }
 
 void oled_set_cursor(uint8_t col, uint8_t line) {
@@ -520,6 +624,121 @@ void oled_write_pixel(uint8_t x, uint8_t y, bool on) {
     }
 }
 
+// Clips the rectangle to the display, returns false if nothing of it is left
+static bool oled_clip(int16_t *x0, int16_t *y0, int16_t *x1, int16_t *y1) {
+    int16_t height = OLED_MATRIX_SIZE / oled_rotation_width * 8;
+    if (*x0 < 0) *x0 = 0;
+    if (*y0 < 0) *y0 = 0;
+    if (*x1 > oled_rotation_width) *x1 = oled_rotation_width;
+    if (*y1 > height) *y1 = height;
+    return *x0 < *x1 && *y0 < *y1;
+}
+
+// Bits of page that lie within rows y0 to y1 - 1
+static uint8_t oled_page_mask(uint8_t page, int16_t y0, int16_t y1) {
+    uint8_t top    = (y0 > page * 8) ? y0 - page * 8 : 0;
+    uint8_t bottom = (y1 < page * 8 + 8) ? y1 - page * 8 : 8;
+    return (uint8_t)(0xFF << top) & (0xFF >> (8 - bottom));
+}
+
+static uint8_t oled_draw_byte(uint8_t data, uint8_t bits, uint8_t mask, oled_draw_mode_t mode) {
+    switch (mode) {
+        case OLED_DRAW_OFF:
+            return data & ~(bits & mask);
+        case OLED_DRAW_ON:
+            return data | (bits & mask);
+        case OLED_DRAW_XOR:
+            return data ^ (bits & mask);
+        default:
+            return (data & ~mask) | (bits & mask);
+    }
+}
+
+// Writes a byte of a drawing, keeping track of the first and last byte of the page that changed
+static void oled_draw_index(uint16_t index, uint8_t data, uint16_t *first, uint16_t *last) {
+    if (oled_buffer[index] == data) {
+        return;
+    }
+    oled_buffer[index] = data;
+    if (index < *first) *first = index;
+    *last = index;
+}
+
+// Blocks holding the bytes that changed, or none if first is past last
+static OLED_BLOCK_TYPE oled_draw_blocks(uint16_t first, uint16_t last) {
+    if (first > last) {
+        return 0;
+    }
+    uint8_t first_block = first / OLED_BLOCK_SIZE;
+    uint8_t count       = last / OLED_BLOCK_SIZE - first_block + 1;
+    return (((OLED_BLOCK_TYPE)1 << (count - 1) << 1) - 1) << first_block;
+}
+
+void oled_fill_rect(int16_t x, int16_t y, uint8_t w, uint8_t h, oled_draw_mode_t mode) {
+    int16_t x0 = x, y0 = y, x1 = x + w, y1 = y + h;
+    if (!oled_clip(&x0, &y0, &x1, &y1)) {
+        return;
+    }
+
+    OLED_BLOCK_TYPE dirty = 0;
+    for (uint8_t page = y0 / 8; page <= (y1 - 1) / 8; page++) {
+        uint8_t  mask  = oled_page_mask(page, y0, y1);
+        uint16_t start = page * oled_rotation_width + x0;
+        uint16_t end   = page * oled_rotation_width + x1;
+        uint16_t first = end, last = 0;
+        for (uint16_t i = start; i < end; i++) {
+            oled_draw_index(i, oled_draw_byte(oled_buffer[i], 0xFF, mask, mode), &first, &last);
+        }
+        dirty |= oled_draw_blocks(first, last);
+    }
+    oled_dirty |= dirty;
+}
+
+void oled_draw_hline(int16_t x, int16_t y, uint8_t w, oled_draw_mode_t mode) { oled_fill_rect(x, y, w, 1, mode); }
+
+void oled_draw_vline(int16_t x, int16_t y, uint8_t h, oled_draw_mode_t mode) { oled_fill_rect(x, y, 1, h, mode); }
+
+static void oled_blit_impl(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *sprite, oled_draw_mode_t mode, bool progmem) {
+    int16_t x0 = x, y0 = y, x1 = x + w, y1 = y + h;
+    if (!oled_clip(&x0, &y0, &x1, &y1)) {
+        return;
+    }
+
+    uint8_t         sprite_pages = (h + 7) / 8;
+    OLED_BLOCK_TYPE dirty        = 0;
+    for (uint8_t page = y0 / 8; page <= (y1 - 1) / 8; page++) {
+        // The page is made of the bottom of sprite page src and the top of sprite page src + 1
+        int16_t  row   = page * 8 - y;
+        int8_t   src   = (row + 8) / 8 - 1;
+        uint8_t  shift = row - src * 8;
+        uint8_t  mask  = oled_page_mask(page, y0, y1);
+        uint16_t start = page * oled_rotation_width + x0;
+        uint16_t end   = page * oled_rotation_width + x1;
+        uint16_t first = end, last = 0;
+
+        const uint8_t *upper = (src >= 0) ? &sprite[src * w + x0 - x] : NULL;
+        const uint8_t *lower = (src + 1 < sprite_pages) ? &sprite[(src + 1) * w + x0 - x] : NULL;
+        for (uint16_t i = start; i < end; i++) {
+            uint8_t bits = 0;
+            if (upper) {
+                bits |= (progmem ? pgm_read_byte(upper) : *upper) >> shift;
+                upper++;
+            }
+            if (lower) {
+                if (shift) {
+                    bits |= (progmem ? pgm_read_byte(lower) : *lower) << (8 - shift);
+                }
+                lower++;
+            }
+            oled_draw_index(i, oled_draw_byte(oled_buffer[i], bits, mask, mode), &first, &last);
+        }
+        dirty |= oled_draw_blocks(first, last);
+    }
+    oled_dirty |= dirty;
+}
+
+void oled_blit(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *sprite, oled_draw_mode_t mode) { oled_blit_impl(x, y, w, h, sprite, mode, false); }
+
 #if defined(__AVR__)
 void oled_write_P(const char *data, bool invert) {
     uint8_t c = pgm_read_byte(data);
@@ -544,6 +763,8 @@ void oled_write_raw_P(const char *data, uint16_t size) {
         oled_dirty |= ((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
     }
 }
+
+void oled_blit_P(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *sprite, oled_draw_mode_t mode) { oled_blit_impl(x, y, w, h, sprite, mode, true); }
 #endif  // defined(__AVR__)
 
 bool oled_on(void) {
@@ -139,6 +139,9 @@ uint16_t pmw_get_cpi(void) {
 
 bool pmw_spi_init(void) {
     setPinOutput(PMW3360_CS_PIN);
+#ifdef PMW3360_MOTION_PIN
+    setPinInputHigh(PMW3360_MOTION_PIN);
+#endif
 
     spi_init();
     _inBurst = false;
@@ -218,7 +221,23 @@ bool pmw_check_signature(void) {
     return (pid == 0x42 && iv_pid == 0xBD && SROM_ver == 0x04);  // signature for SROM 0x04
 }
 
+bool pmw_has_motion(void) {
+#ifdef PMW3360_MOTION_PIN
+    // active low, and released again by the burst read
+    return !readPin(PMW3360_MOTION_PIN);
+#else
+    return true;
+#endif
+}
+
 report_pmw_t pmw_read_burst(void) {
+    if (_inBurst && !pmw_has_motion()) {
+        // nothing new to read, skip the transfer and its tSRAD wait
+        report_pmw_t data = {0};
+        data.isOnSurface  = true;
+        return data;
+    }
+
     if (!_inBurst) {
         dprintf("burst on");
         spi_write_adv(REG_Motion_Burst, 0x00);
@@ -234,7 +253,7 @@ report_pmw_t pmw_read_burst(void) {
     data.dx     = 0;
     data.mdx    = 0;
     data.dy     = 0;
-    data.mdx    = 0;
+    data.mdy    = 0;
 
     data.motion = spi_read();
     spi_write(0x00);  // skip Observation
@@ -77,6 +77,7 @@ void pmw_set_cpi(uint16_t cpi);
 uint16_t pmw_get_cpi(void);
 void pmw_upload_firmware(void);
 bool pmw_check_signature(void);
+bool pmw_has_motion(void);
 report_pmw_t pmw_read_burst(void);
 
 
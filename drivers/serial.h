@@ -33,6 +33,12 @@ void soft_serial_target_init(void);
 #define TRANSACTION_TYPE_ERROR 0x4
 int soft_serial_transaction(int sstd_index);
 
+// pipelined initiator, only provided by the USART driver with SERIAL_USART_PIPELINE
+//   queue sends the transaction without waiting for its reply,
+//   flush reads the replies of everything queued and reports if any of it failed
+int soft_serial_transaction_queue(int sstd_index);
+int soft_serial_transaction_flush(void);
+
 // target status
 // *SSTD_t.status has
 //   initiator:
@@ -57,6 +57,89 @@ static i2c_status_t chibios_to_qmk(const msg_t* status) {
     }
 }
 
+#ifdef I2C_ASYNC
+typedef struct {
+    uint8_t                address;
+    const uint8_t*         data;
+    uint16_t               length;
+    uint16_t               timeout;
+    volatile i2c_status_t* status;
+} i2c_async_transfer_t;
+
+// Ring of queued transfers: only the caller moves the head, only the worker thread moves the tail
+static i2c_async_transfer_t i2c_async_queue[I2C_ASYNC_QUEUE_SIZE];
+static volatile uint8_t     i2c_async_head = 0;
+static volatile uint8_t     i2c_async_tail = 0;
+static semaphore_t          i2c_async_queued;
+static binary_semaphore_t   i2c_async_idle;
+
+static THD_WORKING_AREA(waI2CAsyncThread, 256);
+static THD_FUNCTION(I2CAsyncThread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_async");
+
+    while (true) {
+        chSemWait(&i2c_async_queued);
+
+        // The driver sleeps on the transfer interrupts, the keyboard task runs meanwhile
+        i2c_async_transfer_t* transfer = &i2c_async_queue[i2c_async_tail];
+        i2cStart(&I2C_DRIVER, &i2cconfig);
+        msg_t        msg    = i2cMasterTransmitTimeout(&I2C_DRIVER, (transfer->address >> 1), transfer->data, transfer->length, 0, 0, TIME_MS2I(transfer->timeout));
+        i2c_status_t status = chibios_to_qmk(&msg);
+        if (status != I2C_STATUS_SUCCESS && transfer->status) {
+            *transfer->status = status;
+        }
+
+        i2c_async_tail = (i2c_async_tail + 1) % I2C_ASYNC_QUEUE_SIZE;
+        if (i2c_async_tail == i2c_async_head) {
+            chBSemSignal(&i2c_async_idle);
+        }
+    }
+}
+
+static void i2c_async_init(void) {
+    static bool is_initialised = false;
+    if (!is_initialised) {
+        is_initialised = true;
+        chSemObjectInit(&i2c_async_queued, 0);
+        chBSemObjectInit(&i2c_async_idle, true);
+        // Above the main thread, so that a finished transfer is followed up right away
+        chThdCreateStatic(waI2CAsyncThread, sizeof(waI2CAsyncThread), NORMALPRIO + 1, I2CAsyncThread, NULL);
+    }
+}
+
+bool i2c_async_busy(void) { return i2c_async_head != i2c_async_tail; }
+
+void i2c_async_wait(void) {
+    while (i2c_async_busy()) {
+        chBSemWait(&i2c_async_idle);
+    }
+}
+
+void i2c_transmit_async(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout, volatile i2c_status_t* status) {
+    i2c_async_init();
+
+    uint8_t next = (i2c_async_head + 1) % I2C_ASYNC_QUEUE_SIZE;
+    if (next == i2c_async_tail) {
+        i2c_async_wait();
+    }
+
+    i2c_async_transfer_t* transfer = &i2c_async_queue[i2c_async_head];
+    transfer->address              = address;
+    transfer->data                 = data;
+    transfer->length               = length;
+    transfer->timeout              = timeout;
+    transfer->status               = status;
+    i2c_async_head                 = next;
+    chSemSignal(&i2c_async_queued);
+}
+
+// Synchronous transfers must not interleave with the queued ones
+#    define i2c_async_drain() i2c_async_wait()
+#else
+#    define i2c_async_drain()
+#endif
+
 __attribute__((weak)) void i2c_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
@@ -78,12 +161,14 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_start(uint8_t address) {
+    i2c_async_drain();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     return I2C_STATUS_SUCCESS;
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
@@ -91,6 +176,7 @@ i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length,
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, TIME_MS2I(timeout));
@@ -98,6 +184,7 @@ i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16
 }
 
 i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
@@ -112,10 +199,14 @@ i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data,
 }
 
 i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_async_drain();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
     return chibios_to_qmk(&status);
 }
 
-void i2c_stop(void) { i2cStop(&I2C_DRIVER); }
+void i2c_stop(void) {
+    i2c_async_drain();
+    i2cStop(&I2C_DRIVER);
+}
@@ -98,6 +98,13 @@
 #    endif
 #endif
 
+#ifdef I2C_ASYNC
+/* Number of transfers that can be queued with i2c_transmit_async() */
+#    ifndef I2C_ASYNC_QUEUE_SIZE
+#        define I2C_ASYNC_QUEUE_SIZE 16
+#    endif
+#endif
+
 typedef int16_t i2c_status_t;
 
 #define I2C_STATUS_SUCCESS (0)
@@ -111,3 +118,12 @@ i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16
 i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout);
 i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
 void         i2c_stop(void);
+
+#ifdef I2C_ASYNC
+/* Queues a transmission, sent in the background while the caller carries on.
+ * data must stay untouched until the transfer is done. If status is not NULL,
+ * it is set when the transfer fails. Synchronous calls wait for the queue to drain. */
+void i2c_transmit_async(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout, volatile i2c_status_t* status);
+bool i2c_async_busy(void);
+void i2c_async_wait(void);
+#endif
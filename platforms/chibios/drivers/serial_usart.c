@@ -36,7 +36,11 @@ static SerialDriver* serial_driver = &SERIAL_USART_DRIVER;
 static inline bool react_to_transactions(void);
 static inline bool __attribute__((nonnull)) receive(uint8_t* destination, const size_t size);
 static inline bool __attribute__((nonnull)) send(const uint8_t* source, const size_t size);
+#if !defined(SERIAL_USART_PIPELINE)
 static inline int  initiate_transaction(uint8_t sstd_index);
+#else
+static inline bool complete_transaction(void);
+#endif
 static inline void usart_clear(void);
 
 /**
@@ -248,6 +252,8 @@ void soft_serial_initiator_init(void) {
     sdStart(serial_driver, &serial_config);
 }
 
+#if !defined(SERIAL_USART_PIPELINE)
+
 /**
  * @brief Start transaction from the master half to the slave half.
  *
@@ -316,3 +322,163 @@ static inline int initiate_transaction(uint8_t sstd_index) {
 
     return TRANSACTION_END;
 }
+
+#else  // SERIAL_USART_PIPELINE
+
+/* Transactions sent to the slave whose replies have not been read yet, oldest first.
+ * The slave answers in order, so the replies are matched to them by position.
+ * The buffer sizes are kept as they were when sent, as the RPC transactions resize theirs. */
+typedef struct {
+    uint8_t sstd_index;
+    uint8_t initiator2target_buffer_size;
+    uint8_t target2initiator_buffer_size;
+} pipeline_entry_t;
+
+static pipeline_entry_t pipeline[SERIAL_USART_PIPELINE_DEPTH];
+static uint8_t          pipeline_head     = 0;
+static uint8_t          pipeline_count    = 0;
+static size_t           pipeline_tx_bytes = 0;
+static size_t           pipeline_rx_bytes = 0;
+static int              pipeline_status   = TRANSACTION_END;
+
+/**
+ * @brief Forget the transactions in flight after a failure.
+ * Their replies can't be matched to them anymore and are dropped with the next clear of the receive queue.
+ */
+static inline void abort_transactions(void) {
+    pipeline_count    = 0;
+    pipeline_tx_bytes = 0;
+    pipeline_rx_bytes = 0;
+    pipeline_status   = TRANSACTION_NO_RESPONSE;
+}
+
+/**
+ * @brief Queue a transaction from the master half to the slave half.
+ *
+ * The request is sent right away, but its reply is only read once the pipeline is full
+ * or by soft_serial_transaction_flush(), so the serial turnaround is paid once for all
+ * transactions in flight instead of once per transaction.
+ *
+ * @param index Transaction Table index of the transaction to queue.
+ * @return int TRANSACTION_TYPE_ERROR in case of invalid transaction index.
+ *             TRANSACTION_NO_RESPONSE in case the request could not be sent.
+ *             TRANSACTION_END in case of success.
+ */
+int soft_serial_transaction_queue(int index) {
+    uint8_t sstd_index = (uint8_t)index;
+
+    /* Sanity check that we are actually starting a valid transaction. */
+    if (sstd_index >= NUM_TOTAL_TRANSACTIONS) {
+        dprintln("USART: Illegal transaction Id.");
+        return TRANSACTION_TYPE_ERROR;
+    }
+
+    split_transaction_desc_t* trans = &split_transaction_table[sstd_index];
+
+    /* Transaction is not registered. Abort. */
+    if (!trans->status) {
+        dprintln("USART: Transaction not registered.");
+        return TRANSACTION_TYPE_ERROR;
+    }
+
+    size_t tx_bytes = sizeof(sstd_index) + trans->initiator2target_buffer_size;
+    size_t rx_bytes = sizeof(sstd_index) + trans->target2initiator_buffer_size;
+
+    /* Keep everything in flight within the receive queues of both halves, so nothing is dropped
+     * while the other side is busy. A transaction that doesn't fit on its own is run in lockstep. */
+    while (pipeline_count == SERIAL_USART_PIPELINE_DEPTH || (pipeline_count && (pipeline_tx_bytes + tx_bytes > SERIAL_BUFFERS_SIZE || pipeline_rx_bytes + rx_bytes > SERIAL_BUFFERS_SIZE))) {
+        if (!complete_transaction()) {
+            abort_transactions();
+        }
+    }
+
+    if (!pipeline_count) {
+        /* Clear the receive queue, to start with a clean slate.
+         * Parts of failed transactions or spurious bytes could still be in it. */
+        usart_clear();
+    }
+
+    /* In full duplex the slave takes the buffer right after the index, without waiting for the handshake to arrive here. */
+    if (!send(&sstd_index, sizeof(sstd_index)) || (trans->initiator2target_buffer_size && !send(split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size))) {
+        dprintln("USART: Send failed.");
+        abort_transactions();
+        return TRANSACTION_NO_RESPONSE;
+    }
+
+    pipeline[(pipeline_head + pipeline_count) % SERIAL_USART_PIPELINE_DEPTH] = (pipeline_entry_t){
+        .sstd_index                   = sstd_index,
+        .initiator2target_buffer_size = trans->initiator2target_buffer_size,
+        .target2initiator_buffer_size = trans->target2initiator_buffer_size,
+    };
+    pipeline_count++;
+    pipeline_tx_bytes += tx_bytes;
+    pipeline_rx_bytes += rx_bytes;
+    return TRANSACTION_END;
+}
+
+/**
+ * @brief Read the replies of all queued transactions.
+ *
+ * @return int TRANSACTION_NO_RESPONSE if any transaction queued since the last flush failed.
+ *             TRANSACTION_END in case of success.
+ */
+int soft_serial_transaction_flush(void) {
+    while (pipeline_count) {
+        if (!complete_transaction()) {
+            abort_transactions();
+        }
+    }
+
+    int status      = pipeline_status;
+    pipeline_status = TRANSACTION_END;
+    return status;
+}
+
+/**
+ * @brief Start transaction from the master half to the slave half, and wait for it and
+ * every transaction queued before it to complete.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return int TRANSACTION_NO_RESPONSE in case of Timeout.
+ *             TRANSACTION_TYPE_ERROR in case of invalid transaction index.
+ *             TRANSACTION_END in case of success.
+ */
+int soft_serial_transaction(int index) {
+    int status = soft_serial_transaction_queue(index);
+    if (status == TRANSACTION_TYPE_ERROR) {
+        return status;
+    }
+
+    return soft_serial_transaction_flush();
+}
+
+/**
+ * @brief Read the reply of the oldest transaction in flight.
+ */
+static inline bool complete_transaction(void) {
+    pipeline_entry_t          entry = pipeline[pipeline_head];
+    split_transaction_desc_t* trans = &split_transaction_table[entry.sstd_index];
+
+    pipeline_head = (pipeline_head + 1) % SERIAL_USART_PIPELINE_DEPTH;
+    pipeline_count--;
+    pipeline_tx_bytes -= sizeof(entry.sstd_index) + entry.initiator2target_buffer_size;
+    pipeline_rx_bytes -= sizeof(entry.sstd_index) + entry.target2initiator_buffer_size;
+
+    uint8_t sstd_index_shake = 0xFF;
+    if (!receive(&sstd_index_shake, sizeof(sstd_index_shake)) || (sstd_index_shake != (entry.sstd_index ^ HANDSHAKE_MAGIC))) {
+        dprintln("USART: Handshake failed.");
+        return false;
+    }
+
+    /* Receive transaction buffer from the slave. If this transaction requires it. */
+    if (entry.target2initiator_buffer_size) {
+        if (!receive(split_trans_target2initiator_buffer(trans), entry.target2initiator_buffer_size)) {
+            dprintln("USART: Receive failed.");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#endif  // SERIAL_USART_PIPELINE
@@ -113,4 +113,14 @@
 #    define SERIAL_USART_TIMEOUT 20
 #endif
 
+#if defined(SERIAL_USART_PIPELINE)
+#    if !defined(SERIAL_USART_FULL_DUPLEX)
+#        error "SERIAL_USART_PIPELINE requires SERIAL_USART_FULL_DUPLEX"
+#    endif
+/* Maximum number of transactions sent to the slave before their replies are read. */
+#    if !defined(SERIAL_USART_PIPELINE_DEPTH)
+#        define SERIAL_USART_PIPELINE_DEPTH 4
+#    endif
+#endif
+
 #define HANDSHAKE_MAGIC 7
@@ -1,5 +1,6 @@
 #include "quantum.h"
 #include "ws2812.h"
+#include <string.h>
 
 /* Adapted from https://github.com/gamazeps/ws2812b-chibios-SPIDMA/ */
 
@@ -82,39 +83,44 @@
 
 static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
 
+// Colors of the last frame, so that LEDs that did not change are not encoded again
+static LED_TYPE led_cache[RGBLED_NUM];
+
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
+ * the ws2812b protocol, every bit of a color is sent as a 4 bit pattern:
+ * 0b1000 for a 0 and 0b1110 for a 1, two bits per SPI byte. This table holds
+ * the two SPI bytes for every nibble, so a color byte takes two lookups.
  */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
+static const uint8_t ws2812_nibble_eq[16][2] = {
+    {0x88, 0x88}, {0x88, 0x8E}, {0x88, 0xE8}, {0x88, 0xEE}, {0x8E, 0x88}, {0x8E, 0x8E}, {0x8E, 0xE8}, {0x8E, 0xEE},
+    {0xE8, 0x88}, {0xE8, 0x8E}, {0xE8, 0xE8}, {0xE8, 0xEE}, {0xEE, 0x88}, {0xEE, 0x8E}, {0xEE, 0xE8}, {0xEE, 0xEE},
+};
+
+static inline void set_led_byte(uint8_t* tx, uint8_t data) {
+    const uint8_t* high = ws2812_nibble_eq[data >> 4];
+    const uint8_t* low  = ws2812_nibble_eq[data & 0x0F];
+    tx[0]               = high[0];
+    tx[1]               = high[1];
+    tx[2]               = low[0];
+    tx[3]               = low[1];
 }
 
 static void set_led_color_rgb(LED_TYPE color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
+    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE + BYTES_FOR_LED * pos];
 
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++) tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++) tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++) tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    set_led_byte(tx_start, color.g);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE, color.r);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE * 2, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++) tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++) tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++) tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    set_led_byte(tx_start, color.r);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE, color.g);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE * 2, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++) tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++) tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++) tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
+    set_led_byte(tx_start, color.b);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE, color.g);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE * 2, color.r);
 #endif
 }
 
@@ -144,6 +150,11 @@ void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
     }
 
     for (uint8_t i = 0; i < leds; i++) {
+        // An encoded LED never starts with a zero byte, so this also catches LEDs that were never sent
+        if (txbuf[PREAMBLE_SIZE + BYTES_FOR_LED * i] != 0 && memcmp(&led_cache[i], &ledarray[i], sizeof(LED_TYPE)) == 0) {
+            continue;
+        }
+        led_cache[i] = ledarray[i];
         set_led_color_rgb(ledarray[i], i);
     }
 
@@ -1,4 +1,5 @@
 #include <stdint.h>
+#include <string.h>
 #include "keyboard.h"
 #include "action.h"
 #include "util.h"
@@ -219,6 +220,24 @@ uint8_t read_source_layers_cache(keypos_t key) {
 }
 #endif
 
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+/** \brief layer lookup cache
+ *
+ * Topmost non-transparent layer of each key, valid for the combined layer state
+ * in layer_lookup_cache_state. Entries are resolved lazily on lookup and dropped
+ * whenever the layer state or the keymap changes.
+ */
+static uint8_t       layer_lookup_cache[MATRIX_ROWS][MATRIX_COLS];
+static uint8_t       layer_lookup_cache_valid[(MATRIX_ROWS * MATRIX_COLS + 7) / 8];
+static layer_state_t layer_lookup_cache_state = 0;
+
+/** \brief invalidate layer lookup cache
+ *
+ * Drops every cached entry, call after changing the keymap at runtime.
+ */
+void layer_lookup_cache_invalidate(void) { memset(layer_lookup_cache_valid, 0, sizeof(layer_lookup_cache_valid)); }
+#endif
+
 /** \brief Store or get action (FIXME: Needs better summary)
  *
  * Make sure the action triggered when the key is released is the same
@@ -256,17 +275,41 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     action.code = ACTION_TRANSPARENT;
 
     layer_state_t layers = layer_state | default_layer_state;
+#    ifdef LAYER_LOOKUP_CACHE
+    /* layer_state may also be written directly, so check it here rather than in layer_state_set */
+    if (layers != layer_lookup_cache_state) {
+        layer_lookup_cache_invalidate();
+        layer_lookup_cache_state = layers;
+    }
+
+    const bool     cacheable   = key.row < MATRIX_ROWS && key.col < MATRIX_COLS;
+    const uint16_t key_number  = key.col + (key.row * MATRIX_COLS);
+    const uint8_t  storage_bit = 1U << (key_number % 8);
+    if (cacheable && (layer_lookup_cache_valid[key_number / 8] & storage_bit)) {
+        return layer_lookup_cache[key.row][key.col];
+    }
+#    endif
+
+    /* fall back to layer 0 */
+    uint8_t layer = 0;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
             action = action_for_key(i, key);
             if (action.code != ACTION_TRANSPARENT) {
-                return i;
+                layer = i;
+                break;
             }
         }
     }
-    /* fall back to layer 0 */
-    return 0;
+
+#    ifdef LAYER_LOOKUP_CACHE
+    if (cacheable) {
+        layer_lookup_cache[key.row][key.col] = layer;
+        layer_lookup_cache_valid[key_number / 8] |= storage_bit;
+    }
+#    endif
+    return layer;
 #else
     return get_highest_layer(default_layer_state);
 #endif
@@ -81,12 +81,57 @@ static const dacsample_t dac_buffer_trapezoid[AUDIO_DAC_BUFFER_SIZE] = {0x0,   0
 
 static dacsample_t dac_buffer_empty[AUDIO_DAC_BUFFER_SIZE] = {AUDIO_DAC_OFF_VALUE};
 
-/* keep track of the sample position for for each frequency */
-static float dac_if[AUDIO_MAX_SIMULTANEOUS_TONES] = {0.0};
+#if AUDIO_DAC_BUFFER_SIZE != 256U
+#    error "AUDIO_DAC: the phase accumulator indexes the wavetables with its top 8 bits, AUDIO_DAC_BUFFER_SIZE has to be 256"
+#endif
+
+/* number of samples a voice takes to ramp its amplitude from silent to full;
+ * softens the step in the waveform when a tone starts. The envelope is an attack only:
+ * there is no release, a voice that ends is dropped at a zero crossing of the output
+ */
+#ifndef AUDIO_DAC_ENVELOPE_SAMPLES
+#    define AUDIO_DAC_ENVELOPE_SAMPLES 64
+#endif
+#if AUDIO_DAC_ENVELOPE_SAMPLES < 1
+#    error "AUDIO_DAC_ENVELOPE_SAMPLES has to be at least 1"
+#endif
+
+/* the level the wavetables swing around; voices are mixed around it, so that a silent voice adds nothing */
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+#    define DAC_SAMPLE_MID ((AUDIO_DAC_SAMPLE_MAX + 1) / 2)
+#else
+#    define DAC_SAMPLE_MID 0x800
+#endif
+
+/* full scale amplitude of a voice, in 16.16 fixed point */
+#define DAC_AMPLITUDE_ONE (1UL << 16)
+#define DAC_AMPLITUDE_STEP ((DAC_AMPLITUDE_ONE + AUDIO_DAC_ENVELOPE_SAMPLES - 1) / AUDIO_DAC_ENVELOPE_SAMPLES)
+
+/* keep track of the sample position for for each frequency: the top 8 bits of the
+ * phase are the index into the wavetable, the lower 24 bits the fraction in between */
+static uint32_t dac_phase[AUDIO_MAX_SIMULTANEOUS_TONES]           = {0};
+static uint32_t dac_phase_increment[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
+
+/* per voice amplitude envelope, ramping up to the target amplitude which splits the output range evenly over the active tones */
+static uint32_t dac_amplitude[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
+static uint32_t dac_amplitude_target                         = 0;
 
 static float   active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0, 0};
 static uint8_t active_tones_snapshot_length                        = 0;
 
+/**
+ * Converts a frequency to the per sample advance of the phase accumulator; only called
+ * when the snapshot of the active tones changes, to keep floats out of the per sample path.
+ *
+ * Note: the 2/3 are necessary to get the correct frequencies on the DAC output (as measured
+ *       with an oscilloscope), since the gpt timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the
+ *       DAC callback is called twice per conversion.
+ */
+static uint32_t dac_phase_increment_for(float frequency) {
+    float increment = frequency * 4294967296.0f * 2 / 3 / AUDIO_DAC_SAMPLE_RATE;
+    return increment < 4294967296.0f ? (uint32_t)increment : UINT32_MAX;
+}
+
 typedef enum {
     OUTPUT_SHOULD_START,
     OUTPUT_RUN_NORMALLY,
@@ -114,51 +159,60 @@ __attribute__((weak)) uint16_t dac_value_generate(void) {
     }
 
     /* doing additive wave synthesis over all currently playing tones = adding up
-     * sine-wave-samples for each frequency, scaled by the number of active tones
+     * sine-wave-samples for each frequency, scaled by the amplitude of each voice;
+     * the samples are taken relative to their midpoint, so the amplitude scales them
+     * towards the middle of the DAC range instead of towards 0
      */
-    uint16_t value     = 0;
-    float    frequency = 0.0f;
+    int32_t value = 0;
 
     for (uint8_t i = 0; i < active_tones_snapshot_length; i++) {
         /* Note: a user implementation does not have to rely on the active_tones_snapshot, but
          * could directly query the active frequencies through audio_get_processed_frequency */
-        frequency = active_tones_snapshot[i];
-
-        dac_if[i] = dac_if[i] + ((frequency * AUDIO_DAC_BUFFER_SIZE) / AUDIO_DAC_SAMPLE_RATE) * 2 / 3;
-        /*Note: the 2/3 are necessary to get the correct frequencies on the
-         *      DAC output (as measured with an oscilloscope), since the gpt
-         *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
-         *      is called twice per conversion.*/
+        dac_phase[i] += dac_phase_increment[i];
 
-        dac_if[i] = fmod(dac_if[i], AUDIO_DAC_BUFFER_SIZE);
+        // envelope: ramp up linearly to the target amplitude; dropping to a lower target happens at once,
+        // so the sum over all voices never exceeds full scale
+        if (dac_amplitude[i] < dac_amplitude_target) {
+            dac_amplitude[i] = MIN(dac_amplitude[i] + DAC_AMPLITUDE_STEP, dac_amplitude_target);
+        } else {
+            dac_amplitude[i] = dac_amplitude_target;
+        }
 
         // Wavetable generation/lookup
-        uint16_t dac_i = (uint16_t)dac_if[i];
+        uint8_t dac_i = dac_phase[i] >> 24;
 
 #if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length;
+        value += ((int32_t)dac_buffer_sine[dac_i] - DAC_SAMPLE_MID) * (int32_t)dac_amplitude[i];
 #elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length;
+        value += ((int32_t)dac_buffer_triangle[dac_i] - DAC_SAMPLE_MID) * (int32_t)dac_amplitude[i];
 #elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-        value += dac_buffer_trapezoid[dac_i] / active_tones_snapshot_length;
+        value += ((int32_t)dac_buffer_trapezoid[dac_i] - DAC_SAMPLE_MID) * (int32_t)dac_amplitude[i];
 #elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length;
+        value += ((int32_t)dac_buffer_square[dac_i] - DAC_SAMPLE_MID) * (int32_t)dac_amplitude[i];
 #endif
         /*
         // SINE
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length / 3;
+        value += dac_buffer_sine[dac_i] * dac_amplitude[i] / 3;
         // TRIANGLE
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length / 3;
+        value += dac_buffer_triangle[dac_i] * dac_amplitude[i] / 3;
         // SQUARE
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length / 3;
+        value += dac_buffer_square[dac_i] * dac_amplitude[i] / 3;
         //NOTE: combination of these three wave-forms is more exemplary - and doesn't sound particularly good :-P
         */
 
         // STAIRS (mostly usefully as test-pattern)
-        // value_avg = dac_buffer_staircase[dac_i] / active_tones_snapshot_length;
+        // value = dac_buffer_staircase[dac_i] * dac_amplitude[i];
     }
 
-    return value;
+    // the handover to and from AUDIO_DAC_OFF_VALUE is left to the zero crossing detection in dac_end
+    int32_t sample = (int32_t)DAC_SAMPLE_MID + value / (int32_t)DAC_AMPLITUDE_ONE;
+    if (sample < 0) {
+        return 0;
+    }
+    if (sample > AUDIO_DAC_SAMPLE_MAX) {
+        return AUDIO_DAC_SAMPLE_MAX;
+    }
+    return sample;
 }
 
 /**
@@ -215,15 +269,24 @@ static void dac_end(DACDriver *dacp) {
 
         if ((OUTPUT_SHOULD_START == state) || (OUTPUT_REACHED_ZERO_BEFORE_OFF == state) || (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state)) {
             uint8_t active_tones         = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
+            uint8_t previous_length      = active_tones_snapshot_length;
             active_tones_snapshot_length = 0;
             // update the snapshot - once, and only on occasion that something changed;
-            // -> saves cpu cycles (?)
+            // -> saves cpu cycles, the phase increments only need to be calculated here
             for (uint8_t i = 0; i < active_tones; i++) {
                 float freq = audio_get_processed_frequency(i);
                 if (freq > 0) {  // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
-                    active_tones_snapshot[active_tones_snapshot_length++] = freq;
+                    active_tones_snapshot[active_tones_snapshot_length]  = freq;
+                    dac_phase_increment[active_tones_snapshot_length++] = dac_phase_increment_for(freq);
                 }
             }
+            // voices that were not playing before start silent, and ramp up from there
+            for (uint8_t i = previous_length; i < active_tones_snapshot_length; i++) {
+                dac_amplitude[i] = 0;
+            }
+            if (active_tones_snapshot_length > 0) {
+                dac_amplitude_target = DAC_AMPLITUDE_ONE / active_tones_snapshot_length;
+            }
 
             if ((0 == active_tones_snapshot_length) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
                 state = OUTPUT_OFF;
@@ -327,9 +390,12 @@ void audio_driver_start(void) {
     gptStartContinuous(&GPTD6, 2U);
 
     for (uint8_t i = 0; i < AUDIO_MAX_SIMULTANEOUS_TONES; i++) {
-        dac_if[i]                = 0.0f;
+        dac_phase[i]             = 0;
+        dac_phase_increment[i]   = 0;
+        dac_amplitude[i]         = 0;
         active_tones_snapshot[i] = 0.0f;
     }
     active_tones_snapshot_length = 0;
+    dac_amplitude_target         = 0;
     state                        = OUTPUT_SHOULD_START;
 }
@@ -17,7 +17,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "quantum.h"
 #include "backlight.h"
-#include "eeprom.h"
 #include "eeconfig.h"
 #include "debug.h"
 
@@ -158,9 +157,13 @@ void backlight_level(uint8_t level) {
     eeconfig_update_backlight(backlight_config.raw);
 }
 
-uint8_t eeconfig_read_backlight(void) { return eeprom_read_byte(EECONFIG_BACKLIGHT); }
+uint8_t eeconfig_read_backlight(void) {
+    uint8_t val;
+    eeconfig_read_block(&val, EECONFIG_BACKLIGHT, sizeof(val));
+    return val;
+}
 
-void eeconfig_update_backlight(uint8_t val) { eeprom_update_byte(EECONFIG_BACKLIGHT, val); }
+void eeconfig_update_backlight(uint8_t val) { eeconfig_update_block(&val, EECONFIG_BACKLIGHT, sizeof(val)); }
 
 void eeconfig_update_backlight_current(void) { eeconfig_update_backlight(backlight_config.raw); }
 
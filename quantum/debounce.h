@@ -11,3 +11,14 @@ bool debounce_active(void);
 void debounce_init(uint8_t num_rows);
 
 void debounce_free(void);
+
+// Chatter statistics, only provided by DEBOUNCE_TYPE = sym_eager_pk_adaptive
+
+// number of changes of the key that came sooner than DEBOUNCE_CHATTER_TIME after the previous one
+uint16_t debounce_get_chatter_count(uint8_t row, uint8_t col);
+
+// current debounce time of the key, in milliseconds
+uint8_t debounce_get_key_time(uint8_t row, uint8_t col);
+
+// print the keys that chattered, or whose debounce time changed, to the console
+void debounce_print_chatter(void);
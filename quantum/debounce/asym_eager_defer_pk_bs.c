@@ -0,0 +1,133 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+Bit-sliced version of asym_eager_defer_pk, with identical behaviour.
+The per-key counters are stored as bit planes: plane b of a row holds bit b of the counter of every key
+in that row, so a whole row of counters is updated with a few bitwise operations per plane instead of a
+loop over the keys. Storage is static, sized for MATRIX_ROWS.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+#include <string.h>
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 127ms
+#if DEBOUNCE > 127
+#    undef DEBOUNCE
+#    define DEBOUNCE 127
+#endif
+
+#include "bit_sliced_counters.h"
+
+#if DEBOUNCE > 0
+static matrix_row_t debounce_counters[MATRIX_ROWS][DEBOUNCE_BITS];
+static matrix_row_t debounce_pressed[MATRIX_ROWS];  // direction of the change each running counter is for
+static fast_timer_t last_time;
+static bool         counters_need_update;
+static bool         matrix_need_update;
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    memset(debounce_counters, 0, sizeof(debounce_counters));
+    memset(debounce_pressed, 0, sizeof(debounce_pressed));
+    counters_need_update = false;
+    matrix_need_update   = false;
+}
+
+void debounce_free(void) {}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed || matrix_need_update) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        transfer_matrix_values(raw, cooked, num_rows);
+    }
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    matrix_need_update   = false;
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t expired = counters_elapse(debounce_counters[row], elapsed_time);
+
+        // key-down: eager
+        if (expired & debounce_pressed[row]) {
+            matrix_need_update = true;
+        }
+
+        // key-up: defer
+        matrix_row_t released = expired & ~debounce_pressed[row];
+        cooked[row]           = (cooked[row] & ~released) | (raw[row] & released);
+
+        if (counters_active(debounce_counters[row])) {
+            counters_need_update = true;
+        }
+    }
+}
+
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta  = raw[row] ^ cooked[row];
+        matrix_row_t active = counters_active(debounce_counters[row]);
+        matrix_row_t start  = delta & ~active;
+
+        // key-up: defer, a release that bounced back before DEBOUNCE ms is forgotten
+        counters_clear(debounce_counters[row], ~delta & active & ~debounce_pressed[row]);
+
+        if (start) {
+            debounce_pressed[row] = (debounce_pressed[row] & ~start) | (raw[row] & start);
+            counters_start(debounce_counters[row], start);
+            counters_need_update = true;
+
+            // key-down: eager
+            cooked[row] ^= start & raw[row];
+        }
+    }
+}
+
+bool debounce_active(void) { return true; }
+#else
+#    include "none.c"
+#endif
@@ -0,0 +1,93 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+Bit-sliced per-key counters shared by the *_pk_bs debounce algorithms.
+Plane b of a row holds bit b of the counter of every key in that row; a counter runs from DEBOUNCE
+down to 0, and a key whose counter is 0 is idle. Include after DEBOUNCE has been defined and clamped.
+*/
+
+#pragma once
+
+#include "matrix.h"
+
+#if DEBOUNCE < 2
+#    define DEBOUNCE_BITS 1
+#elif DEBOUNCE < 4
+#    define DEBOUNCE_BITS 2
+#elif DEBOUNCE < 8
+#    define DEBOUNCE_BITS 3
+#elif DEBOUNCE < 16
+#    define DEBOUNCE_BITS 4
+#elif DEBOUNCE < 32
+#    define DEBOUNCE_BITS 5
+#elif DEBOUNCE < 64
+#    define DEBOUNCE_BITS 6
+#elif DEBOUNCE < 128
+#    define DEBOUNCE_BITS 7
+#else
+#    define DEBOUNCE_BITS 8
+#endif
+
+// keys of the row whose counter is running
+static inline matrix_row_t counters_active(const matrix_row_t planes[]) {
+    matrix_row_t active = 0;
+    for (uint8_t b = 0; b < DEBOUNCE_BITS; b++) {
+        active |= planes[b];
+    }
+    return active;
+}
+
+// set the counters of the keys in mask to DEBOUNCE
+static inline void counters_start(matrix_row_t planes[], matrix_row_t mask) {
+    for (uint8_t b = 0; b < DEBOUNCE_BITS; b++) {
+        if (DEBOUNCE & (1 << b)) {
+            planes[b] |= mask;
+        } else {
+            planes[b] &= ~mask;
+        }
+    }
+}
+
+static inline void counters_clear(matrix_row_t planes[], matrix_row_t mask) {
+    for (uint8_t b = 0; b < DEBOUNCE_BITS; b++) {
+        planes[b] &= ~mask;
+    }
+}
+
+// subtract elapsed_time from every running counter of the row and return the keys whose counter expired
+static inline matrix_row_t counters_elapse(matrix_row_t planes[], uint8_t elapsed_time) {
+    matrix_row_t active = counters_active(planes);
+    if (!active) return 0;
+
+    // no counter is above DEBOUNCE, so this expires the same keys and keeps the subtrahend within DEBOUNCE_BITS
+    if (elapsed_time > DEBOUNCE) elapsed_time = DEBOUNCE;
+
+    matrix_row_t borrow    = 0;
+    matrix_row_t remaining = 0;
+    for (uint8_t b = 0; b < DEBOUNCE_BITS; b++) {
+        matrix_row_t counter    = planes[b];
+        matrix_row_t subtrahend = (elapsed_time & (1 << b)) ? ~(matrix_row_t)0 : 0;
+        planes[b]               = (counter ^ subtrahend ^ borrow) & active;
+        borrow                  = (~counter & (subtrahend | borrow)) | (subtrahend & borrow);
+        remaining |= planes[b];
+    }
+
+    // expired when the subtraction reached zero or went below it
+    matrix_row_t expired = active & (borrow | ~remaining);
+    counters_clear(planes, expired);
+    return expired;
+}
@@ -0,0 +1,225 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+Per-key algorithm with a debounce time for every key, adapted to how much that key chatters.
+Like sym_eager_pk, a key changes state immediately and then ignores input for its debounce time.
+A change that comes sooner than DEBOUNCE_CHATTER_TIME after the previous one is counted as
+chatter, and doubles the debounce time of the key (up to DEBOUNCE_MAX); every DEBOUNCE_ADAPT_CLEAN
+changes without chatter lower it by 1ms again (down to DEBOUNCE_MIN). Healthy switches end up with
+a short debounce time, while a worn switch only slows down itself.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+#include "debounce.h"
+#include <stdlib.h>
+
+#ifdef PROTOCOL_CHIBIOS
+#    if CH_CFG_USE_MEMCORE == FALSE
+#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with this debounce algorithm.
+#    endif
+#endif
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+#ifndef DEBOUNCE_MIN
+#    define DEBOUNCE_MIN 1
+#endif
+
+#ifndef DEBOUNCE_MAX
+#    define DEBOUNCE_MAX 10
+#endif
+
+#ifndef DEBOUNCE_CHATTER_TIME
+#    define DEBOUNCE_CHATTER_TIME 20
+#endif
+
+#ifndef DEBOUNCE_ADAPT_CLEAN
+#    define DEBOUNCE_ADAPT_CLEAN 64
+#endif
+
+#if DEBOUNCE_MIN < 1 || DEBOUNCE_MIN > DEBOUNCE_MAX
+#    error "DEBOUNCE_MIN has to be between 1 and DEBOUNCE_MAX"
+#endif
+
+#if DEBOUNCE_CHATTER_TIME <= DEBOUNCE_MAX || DEBOUNCE_CHATTER_TIME > UINT8_MAX
+#    error "DEBOUNCE_CHATTER_TIME has to be above DEBOUNCE_MAX, and at most 255"
+#endif
+
+#if DEBOUNCE > 0 && DEBOUNCE < DEBOUNCE_MIN
+#    define DEBOUNCE_INITIAL DEBOUNCE_MIN
+#elif DEBOUNCE > DEBOUNCE_MAX
+#    define DEBOUNCE_INITIAL DEBOUNCE_MAX
+#else
+#    define DEBOUNCE_INITIAL DEBOUNCE
+#endif
+
+#if DEBOUNCE > 0
+#    define ROW_SHIFTER ((matrix_row_t)1)
+
+typedef struct {
+    uint8_t  age;     // time since the last accepted change, stops at DEBOUNCE_CHATTER_TIME
+    uint8_t  time;    // current debounce time of the key
+    uint8_t  clean;   // changes without chatter since the debounce time was last lowered
+    uint16_t chatter; // number of changes that were counted as chatter
+} debounce_key_t;
+
+static debounce_key_t *debounce_keys;
+static uint8_t         debounce_rows;
+static fast_timer_t    last_time;
+static bool            counters_need_update;
+static bool            matrix_need_update;
+
+static void update_debounce_counters(uint8_t num_rows, uint8_t elapsed_time);
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    debounce_keys = (debounce_key_t *)malloc(num_rows * MATRIX_COLS * sizeof(debounce_key_t));
+    debounce_rows = num_rows;
+    for (uint16_t i = 0; i < num_rows * MATRIX_COLS; i++) {
+        debounce_keys[i] = (debounce_key_t){.age = DEBOUNCE_CHATTER_TIME, .time = DEBOUNCE_INITIAL};
+    }
+    counters_need_update = false;
+    matrix_need_update   = false;
+}
+
+void debounce_free(void) {
+    free(debounce_keys);
+    debounce_keys = NULL;
+    debounce_rows = 0;
+}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters(num_rows, elapsed_time);
+        }
+    }
+
+    if (changed || matrix_need_update) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        transfer_matrix_values(raw, cooked, num_rows);
+    }
+}
+
+// Age the keys that changed recently; a key whose debounce time ran out may have to follow the raw matrix.
+static void update_debounce_counters(uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    matrix_need_update   = false;
+    debounce_key_t *key  = debounce_keys;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (key->age < DEBOUNCE_CHATTER_TIME) {
+                uint8_t age = (DEBOUNCE_CHATTER_TIME - key->age <= elapsed_time) ? DEBOUNCE_CHATTER_TIME : key->age + elapsed_time;
+                if (key->age < key->time && age >= key->time) {
+                    matrix_need_update = true;
+                }
+                key->age = age;
+                if (age < DEBOUNCE_CHATTER_TIME) {
+                    counters_need_update = true;
+                }
+            }
+            key++;
+        }
+    }
+}
+
+static void adapt_debounce_time(debounce_key_t *key) {
+    if (key->age < DEBOUNCE_CHATTER_TIME) {
+        if (key->chatter < UINT16_MAX) {
+            key->chatter++;
+        }
+        key->time  = (key->time * 2 > DEBOUNCE_MAX) ? DEBOUNCE_MAX : key->time * 2;
+        key->clean = 0;
+    } else if (++key->clean >= DEBOUNCE_ADAPT_CLEAN) {
+        key->clean = 0;
+        if (key->time > DEBOUNCE_MIN) {
+            key->time--;
+        }
+    }
+}
+
+// upload from raw_matrix to final matrix;
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    debounce_key_t *key = debounce_keys;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta        = raw[row] ^ cooked[row];
+        matrix_row_t existing_row = cooked[row];
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            matrix_row_t col_mask = (ROW_SHIFTER << col);
+            if ((delta & col_mask) && key->age >= key->time) {
+                adapt_debounce_time(key);
+                key->age             = 0;
+                counters_need_update = true;
+                existing_row ^= col_mask;  // flip the bit.
+            }
+            key++;
+        }
+        cooked[row] = existing_row;
+    }
+}
+
+bool debounce_active(void) { return true; }
+
+static debounce_key_t *debounce_key(uint8_t row, uint8_t col) {
+    if (debounce_keys == NULL || row >= debounce_rows || col >= MATRIX_COLS) {
+        return NULL;
+    }
+    return &debounce_keys[row * MATRIX_COLS + col];
+}
+
+uint16_t debounce_get_chatter_count(uint8_t row, uint8_t col) {
+    debounce_key_t *key = debounce_key(row, col);
+    return key ? key->chatter : 0;
+}
+
+uint8_t debounce_get_key_time(uint8_t row, uint8_t col) {
+    debounce_key_t *key = debounce_key(row, col);
+    return key ? key->time : 0;
+}
+
+void debounce_print_chatter(void) {
+    for (uint8_t row = 0; row < debounce_rows; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            debounce_key_t *key = debounce_key(row, col);
+            if (key->chatter || key->time != DEBOUNCE_INITIAL) {
+                uprintf("debounce %u,%u: chatter=%u time=%ums\n", row, col, key->chatter, key->time);
+            }
+        }
+    }
+}
+#else
+#    include "none.c"
+#endif
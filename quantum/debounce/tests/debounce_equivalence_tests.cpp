@@ -0,0 +1,118 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "quantum.h"
+#include "timer.h"
+#include "debounce.h"
+
+void debounce_reference_init(uint8_t num_rows);
+void debounce_reference(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_reference_free(void);
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+/* Feeds the same noisy input to the algorithm under test and the one it replaces */
+class DebounceEquivalenceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        set_time(7777);
+        debounce_init(MATRIX_ROWS);
+        debounce_reference_init(MATRIX_ROWS);
+    }
+
+    void TearDown() override {
+        debounce_free();
+        debounce_reference_free();
+    }
+
+    /* Toggle each key with the given probability, returns whether anything changed */
+    bool bounce(std::mt19937 &rng, double probability) {
+        std::bernoulli_distribution toggle(probability);
+        bool changed = false;
+
+        for (int row = 0; row < MATRIX_ROWS; row++) {
+            for (int col = 0; col < MATRIX_COLS; col++) {
+                if (toggle(rng)) {
+                    raw_[row] ^= (matrix_row_t)1 << col;
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
+    matrix_row_t raw_[MATRIX_ROWS] = {0};
+    matrix_row_t cooked_[MATRIX_ROWS] = {0};
+    matrix_row_t reference_cooked_[MATRIX_ROWS] = {0};
+};
+
+TEST_F(DebounceEquivalenceTest, MatchesReferenceOnRandomInput) {
+    std::mt19937 rng(20210801);
+    std::uniform_int_distribution<int> step(0, 99);
+
+    for (int scan = 0; scan < 200000; scan++) {
+        /* Mostly 0-2ms between scans, with the occasional long gap */
+        int r = step(rng);
+        advance_time(r < 40 ? 0 : r < 80 ? 1 : r < 98 ? 2 : 20 + r * 3);
+
+        bool changed = bounce(rng, 0.02);
+        debounce(raw_, cooked_, MATRIX_ROWS, changed);
+        debounce_reference(raw_, reference_cooked_, MATRIX_ROWS, changed);
+
+        ASSERT_TRUE(std::equal(std::begin(cooked_), std::end(cooked_), std::begin(reference_cooked_))) << "diverged at scan " << scan;
+    }
+}
+
+TEST_F(DebounceEquivalenceTest, Benchmark) {
+    const int scans = 100000;
+    std::mt19937 rng(1);
+
+    /* Pre-generate the input so both runs see the same scans and the generator isn't timed */
+    std::vector<std::array<matrix_row_t, MATRIX_ROWS>> inputs(scans);
+    for (auto &input : inputs) {
+        bounce(rng, 0.01);
+        std::copy(std::begin(raw_), std::end(raw_), input.begin());
+    }
+
+    auto run = [&](void (*function)(matrix_row_t[], matrix_row_t[], uint8_t, bool), matrix_row_t cooked[]) {
+        set_time(7777);
+        auto start = std::chrono::steady_clock::now();
+        for (int scan = 0; scan < scans; scan++) {
+            std::copy(inputs[scan].begin(), inputs[scan].end(), std::begin(raw_));
+            function(raw_, cooked, MATRIX_ROWS, scan == 0 || inputs[scan] != inputs[scan - 1]);
+            advance_time(1);
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / scans;
+    };
+
+    double bitsliced = run(&debounce, cooked_);
+    double reference = run(&debounce_reference, reference_cooked_);
+
+    std::cout << "[ BENCHMARK] " << MATRIX_ROWS << "x" << MATRIX_COLS << " matrix: " << bitsliced << " ns/scan, reference " << reference << " ns/scan" << std::endl;
+    EXPECT_TRUE(std::equal(std::begin(cooked_), std::end(cooked_), std::begin(reference_cooked_)));
+}
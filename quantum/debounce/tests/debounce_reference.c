@@ -0,0 +1,32 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Builds the algorithm a bit-sliced variant must match, renamed so both can be linked into one test */
+
+#define debounce_init debounce_reference_init
+#define debounce_free debounce_reference_free
+#define debounce debounce_reference
+#define debounce_active debounce_reference_active
+
+#if defined(DEBOUNCE_REFERENCE_SYM_DEFER_PK)
+#    include "../sym_defer_pk.c"
+#elif defined(DEBOUNCE_REFERENCE_SYM_EAGER_PK)
+#    include "../sym_eager_pk.c"
+#elif defined(DEBOUNCE_REFERENCE_ASYM_EAGER_DEFER_PK)
+#    include "../asym_eager_defer_pk.c"
+#else
+#    error No reference debounce algorithm selected
+#endif
@@ -33,6 +33,11 @@ debounce_sym_eager_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_eager_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/sym_eager_pk_tests.cpp
 
+debounce_sym_eager_pk_adaptive_DEFS := $(DEBOUNCE_COMMON_DEFS) -DDEBOUNCE_MIN=2 -DDEBOUNCE_MAX=10 -DDEBOUNCE_CHATTER_TIME=20 -DDEBOUNCE_ADAPT_CLEAN=4
+debounce_sym_eager_pk_adaptive_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_eager_pk_adaptive.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_eager_pk_adaptive_tests.cpp
+
 debounce_sym_eager_pr_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_sym_eager_pr_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_eager_pr.c \
@@ -42,3 +47,24 @@ debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_asym_eager_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+debounce_sym_defer_pk_bs_DEFS := $(DEBOUNCE_COMMON_DEFS) -DDEBOUNCE_REFERENCE_SYM_DEFER_PK
+debounce_sym_defer_pk_bs_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk_bs.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/debounce_reference.c \
+	$(QUANTUM_PATH)/debounce/tests/debounce_equivalence_tests.cpp
+
+debounce_sym_eager_pk_bs_DEFS := $(DEBOUNCE_COMMON_DEFS) -DDEBOUNCE_REFERENCE_SYM_EAGER_PK
+debounce_sym_eager_pk_bs_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_eager_pk_bs.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_eager_pk_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/debounce_reference.c \
+	$(QUANTUM_PATH)/debounce/tests/debounce_equivalence_tests.cpp
+
+debounce_asym_eager_defer_pk_bs_DEFS := $(DEBOUNCE_COMMON_DEFS) -DDEBOUNCE_REFERENCE_ASYM_EAGER_DEFER_PK
+debounce_asym_eager_defer_pk_bs_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk_bs.c \
+	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/debounce_reference.c \
+	$(QUANTUM_PATH)/debounce/tests/debounce_equivalence_tests.cpp
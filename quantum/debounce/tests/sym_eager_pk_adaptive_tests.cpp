@@ -0,0 +1,159 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include "debounce_test_common.h"
+
+extern "C" {
+#include "debounce.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+TEST_F(DebounceTest, OneKeyClean) {
+    addEvents({ /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {{0, 1, DOWN}}},
+        {1, {{0, 1, UP}}, {}},
+        {4, {{0, 1, DOWN}}, {}},
+
+        /* Bounces that have settled before the debounce time ends are not chatter */
+        {30, {{0, 1, UP}}, {{0, 1, UP}}},
+        {31, {{0, 1, DOWN}}, {}},
+        {33, {{0, 1, UP}}, {}},
+        {60, {{0, 1, DOWN}}, {{0, 1, DOWN}}},
+        {61, {{0, 1, UP}}, {}},
+        {62, {{0, 1, DOWN}}, {}},
+        {90, {{0, 1, UP}}, {{0, 1, UP}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, OneKeyChatter) {
+    addEvents({ /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {{0, 1, DOWN}}},
+        {1, {{0, 1, UP}}, {}},
+
+        /* Key up 5ms after key down is chatter, the debounce time of the key goes up to 10ms */
+        {5, {}, {{0, 1, UP}}},
+        {6, {{0, 1, DOWN}}, {}},
+        {15, {}, {{0, 1, DOWN}}},
+
+        /* Other keys are not affected */
+        {20, {{0, 2, DOWN}}, {{0, 2, DOWN}}},
+        {21, {{0, 2, UP}}, {}},
+        {25, {}, {{0, 2, UP}}},
+
+        {40, {{0, 1, UP}}, {{0, 1, UP}}},
+        {41, {{0, 1, DOWN}}, {}},
+        {50, {}, {{0, 1, DOWN}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, OneKeyChatterMax) {
+    addEvents({ /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {{0, 1, DOWN}}},
+        {1, {{0, 1, UP}}, {}},
+        {5, {}, {{0, 1, UP}}},
+        {6, {{0, 1, DOWN}}, {}},
+        {15, {}, {{0, 1, DOWN}}},
+        {16, {{0, 1, UP}}, {}},
+
+        /* Debounce time does not go above DEBOUNCE_MAX */
+        {25, {}, {{0, 1, UP}}},
+        {26, {{0, 1, DOWN}}, {}},
+        {35, {}, {{0, 1, DOWN}}},
+    });
+    runEvents();
+}
+
+class DebounceAdaptiveTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::fill(std::begin(raw_), std::end(raw_), 0);
+        std::fill(std::begin(cooked_), std::end(cooked_), 0);
+        set_time(7777);
+        debounce_init(MATRIX_ROWS);
+    }
+
+    void TearDown() override { debounce_free(); }
+
+    /* Change the key and scan until the debounced matrix follows it */
+    void toggle(uint8_t row, uint8_t col) {
+        raw_[row] ^= (matrix_row_t)1 << col;
+        debounce(raw_, cooked_, MATRIX_ROWS, true);
+        while (raw_[row] != cooked_[row]) {
+            advance_time(1);
+            debounce(raw_, cooked_, MATRIX_ROWS, false);
+        }
+    }
+
+    void wait(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            debounce(raw_, cooked_, MATRIX_ROWS, false);
+        }
+    }
+
+    matrix_row_t raw_[MATRIX_ROWS];
+    matrix_row_t cooked_[MATRIX_ROWS];
+};
+
+TEST_F(DebounceAdaptiveTest, InitialState) {
+    EXPECT_EQ(debounce_get_key_time(0, 0), DEBOUNCE);
+    EXPECT_EQ(debounce_get_chatter_count(0, 0), 0);
+    EXPECT_EQ(debounce_get_key_time(MATRIX_ROWS, 0), 0);
+    EXPECT_EQ(debounce_get_chatter_count(0, MATRIX_COLS), 0);
+}
+
+TEST_F(DebounceAdaptiveTest, ChatterIsCounted) {
+    toggle(1, 2);
+    wait(1);
+    toggle(1, 2);
+    EXPECT_EQ(debounce_get_chatter_count(1, 2), 1);
+    EXPECT_EQ(debounce_get_key_time(1, 2), DEBOUNCE_MAX);
+
+    wait(1);
+    toggle(1, 2);
+    EXPECT_EQ(debounce_get_chatter_count(1, 2), 2);
+    EXPECT_EQ(debounce_get_key_time(1, 2), DEBOUNCE_MAX);
+
+    EXPECT_EQ(debounce_get_chatter_count(1, 3), 0);
+    EXPECT_EQ(debounce_get_key_time(1, 3), DEBOUNCE);
+}
+
+TEST_F(DebounceAdaptiveTest, CleanChangesLowerTime) {
+    toggle(2, 0);
+    wait(1);
+    toggle(2, 0);
+    ASSERT_EQ(debounce_get_key_time(2, 0), DEBOUNCE_MAX);
+
+    for (int i = 0; i < DEBOUNCE_ADAPT_CLEAN; i++) {
+        wait(DEBOUNCE_CHATTER_TIME);
+        toggle(2, 0);
+    }
+    EXPECT_EQ(debounce_get_key_time(2, 0), DEBOUNCE_MAX - 1);
+
+    /* Never goes below DEBOUNCE_MIN */
+    for (int i = 0; i < DEBOUNCE_ADAPT_CLEAN * (DEBOUNCE_MAX + 1); i++) {
+        wait(DEBOUNCE_CHATTER_TIME);
+        toggle(2, 0);
+    }
+    EXPECT_EQ(debounce_get_key_time(2, 0), DEBOUNCE_MIN);
+    EXPECT_EQ(debounce_get_chatter_count(2, 0), 1);
+}
@@ -14,13 +14,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "config.h"
 #include "keymap.h"  // to get keymaps[][][]
 #include "tmk_core/common/eeprom.h"
 #include "progmem.h"  // to read default from flash
 #include "quantum.h"  // for send_string()
 #include "dynamic_keymap.h"
 #include "via.h"  // for default VIA_EEPROM_ADDR_END
+#include <string.h>
 
 #ifndef DYNAMIC_KEYMAP_LAYER_COUNT
 #    define DYNAMIC_KEYMAP_LAYER_COUNT 4
@@ -81,32 +81,110 @@
 #    define DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE (DYNAMIC_KEYMAP_EEPROM_MAX_ADDR - DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + 1)
 #endif
 
+#define DYNAMIC_KEYMAP_EEPROM_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// Copy of the keymaps in EEPROM, in the same big endian layout, loaded on first use.
+// Keycode lookups only read RAM, and changes are written back to EEPROM as one block.
+static uint8_t dynamic_keymap_mirror[DYNAMIC_KEYMAP_EEPROM_SIZE];
+static bool    dynamic_keymap_mirror_loaded = false;
+
+static uint8_t *dynamic_keymap_mirror_get(void) {
+    if (!dynamic_keymap_mirror_loaded) {
+        eeprom_read_block(dynamic_keymap_mirror, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, DYNAMIC_KEYMAP_EEPROM_SIZE);
+        dynamic_keymap_mirror_loaded = true;
+    }
+    return dynamic_keymap_mirror;
+}
+
+// Copies data into the mirror, and writes the range from the first to the last changed byte to EEPROM
+static void dynamic_keymap_mirror_update(uint16_t offset, uint16_t size, const uint8_t *data) {
+    uint8_t *mirror = dynamic_keymap_mirror_get() + offset;
+    uint16_t start  = size;
+    uint16_t end    = 0;
+    for (uint16_t i = 0; i < size; i++) {
+        if (mirror[i] != data[i]) {
+            mirror[i] = data[i];
+            if (start == size) {
+                start = i;
+            }
+            end = i + 1;
+        }
+    }
+    if (end > start) {
+        eeprom_update_block(&mirror[start], (uint8_t *)DYNAMIC_KEYMAP_EEPROM_ADDR + offset + start, end - start);
+    }
+}
+#endif
+
+// Number of bytes from offset that are within a buffer of the given size
+static uint16_t dynamic_keymap_valid_size(uint16_t offset, uint16_t size, uint16_t buffer_size) {
+    if (offset >= buffer_size) {
+        return 0;
+    }
+    return (size < buffer_size - offset) ? size : buffer_size - offset;
+}
+
 uint8_t dynamic_keymap_get_layer_count(void) { return DYNAMIC_KEYMAP_LAYER_COUNT; }
 
+static uint16_t dynamic_keymap_key_to_offset(uint8_t layer, uint8_t row, uint8_t column) {
+    return (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
+}
+
 void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column) {
     // TODO: optimize this with some left shifts
-    return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
+    return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + dynamic_keymap_key_to_offset(layer, row, column);
 }
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    const uint8_t *keycode = dynamic_keymap_mirror_get() + dynamic_keymap_key_to_offset(layer, row, column);
+    return (keycode[0] << 8) | keycode[1];
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
     keycode |= eeprom_read_byte(address + 1);
     return keycode;
+#endif
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    // Big endian, so we can read/write EEPROM directly from host if we want
+    uint8_t data[2] = {(uint8_t)(keycode >> 8), (uint8_t)(keycode & 0xFF)};
+    dynamic_keymap_mirror_update(dynamic_keymap_key_to_offset(layer, row, column), sizeof(data), data);
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#endif
+    layer_lookup_cache_invalidate();
 }
 
 void dynamic_keymap_reset(void) {
     // Reset the keymaps in EEPROM to what is in flash.
     // All keyboards using dynamic keymaps should define a layout
     // for the same number of layers as DYNAMIC_KEYMAP_LAYER_COUNT.
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    // The EEPROM may have been erased underneath the mirror, so rebuild it and write all of it back
+    uint8_t *mirror = dynamic_keymap_mirror;
+    for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (int row = 0; row < MATRIX_ROWS; row++) {
+            for (int column = 0; column < MATRIX_COLS; column++) {
+                uint16_t keycode = pgm_read_word(&keymaps[layer][row][column]);
+                *mirror++        = (uint8_t)(keycode >> 8);
+                *mirror++        = (uint8_t)(keycode & 0xFF);
+            }
+        }
+    }
+    dynamic_keymap_mirror_loaded = true;
+    eeprom_update_block(dynamic_keymap_mirror, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, DYNAMIC_KEYMAP_EEPROM_SIZE);
+    layer_lookup_cache_invalidate();
+#else
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
         for (int row = 0; row < MATRIX_ROWS; row++) {
             for (int column = 0; column < MATRIX_COLS; column++) {
@@ -114,34 +192,27 @@ void dynamic_keymap_reset(void) {
             }
         }
     }
+#endif
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+    uint16_t valid = dynamic_keymap_valid_size(offset, size, DYNAMIC_KEYMAP_EEPROM_SIZE);
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    memcpy(data, dynamic_keymap_mirror_get() + offset, valid);
+#else
+    eeprom_read_block(data, (uint8_t *)DYNAMIC_KEYMAP_EEPROM_ADDR + offset, valid);
+#endif
+    memset(data + valid, 0x00, size - valid);
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
-    }
+    uint16_t valid = dynamic_keymap_valid_size(offset, size, DYNAMIC_KEYMAP_EEPROM_SIZE);
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    dynamic_keymap_mirror_update(offset, valid, data);
+#else
+    eeprom_update_block(data, (uint8_t *)DYNAMIC_KEYMAP_EEPROM_ADDR + offset, valid);
+#endif
+    layer_lookup_cache_invalidate();
 }
 
 // This overrides the one in quantum/keymap_common.c
@@ -158,29 +229,14 @@ uint8_t dynamic_keymap_macro_get_count(void) { return DYNAMIC_KEYMAP_MACRO_COUNT
 uint16_t dynamic_keymap_macro_get_buffer_size(void) { return DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE; }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *target = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+    uint16_t valid = dynamic_keymap_valid_size(offset, size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    eeprom_read_block(data, (uint8_t *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset, valid);
+    memset(data + valid, 0x00, size - valid);
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
-    }
+    uint16_t valid = dynamic_keymap_valid_size(offset, size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    eeprom_update_block(data, (uint8_t *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset, valid);
 }
 
 void dynamic_keymap_macro_reset(void) {
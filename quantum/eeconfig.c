@@ -17,12 +17,134 @@
 #    include "haptic.h"
 #endif
 
+#ifdef EECONFIG_WRITE_BACK
+#    include <string.h>
+#    include "timer.h"
+#endif
+
 #if defined(VIA_ENABLE)
 bool via_eeprom_is_valid(void);
 void via_eeprom_set_valid(bool valid);
 void eeconfig_init_via(void);
 #endif
 
+#ifdef EECONFIG_WRITE_BACK
+/* Pending eeconfig bytes, committed to EEPROM once updates stop for
+ * EECONFIG_WRITE_BACK_DELAY milliseconds. Repeated updates of the same
+ * setting only touch RAM, so holding down a hue or brightness key costs
+ * a single EEPROM write instead of one per step. */
+static uint8_t  write_back_data[EECONFIG_SIZE];
+static uint8_t  write_back_dirty[(EECONFIG_SIZE + 7) / 8];
+static bool     write_back_pending = false;
+static uint32_t write_back_timer   = 0;
+
+static inline bool write_back_is_dirty(uintptr_t offset) { return write_back_dirty[offset / 8] & (1 << (offset % 8)); }
+
+// Drop pending changes, for when the whole eeconfig is about to be rewritten
+static void write_back_discard(void) {
+    memset(write_back_dirty, 0, sizeof(write_back_dirty));
+    write_back_pending = false;
+}
+
+/** \brief eeconfig is dirty
+ *
+ * Returns true while eeconfig updates are waiting to be committed to EEPROM.
+ */
+bool eeconfig_is_dirty(void) { return write_back_pending; }
+
+/** \brief eeconfig flush
+ *
+ * Commits the pending eeconfig updates to EEPROM, one block per run of changed bytes.
+ */
+void eeconfig_flush(void) {
+    if (!write_back_pending) return;
+
+    uintptr_t offset = 0;
+    while (offset < EECONFIG_SIZE) {
+        if (!write_back_is_dirty(offset)) {
+            offset++;
+            continue;
+        }
+        uintptr_t start = offset;
+        while (offset < EECONFIG_SIZE && write_back_is_dirty(offset)) {
+            offset++;
+        }
+        eeprom_update_block(&write_back_data[start], (void *)start, offset - start);
+    }
+    write_back_discard();
+}
+
+/** \brief eeconfig task
+ *
+ * Commits the pending eeconfig updates once no update came in for EECONFIG_WRITE_BACK_DELAY milliseconds.
+ */
+void eeconfig_task(void) {
+    if (write_back_pending && timer_elapsed32(write_back_timer) >= EECONFIG_WRITE_BACK_DELAY) {
+        eeconfig_flush();
+    }
+}
+#endif
+
+/** \brief eeconfig read block
+ *
+ * Reads a block of eeconfig, including updates that are not committed to EEPROM yet.
+ */
+void eeconfig_read_block(void *buf, const void *addr, size_t len) {
+    eeprom_read_block(buf, addr, len);
+#ifdef EECONFIG_WRITE_BACK
+    if (write_back_pending) {
+        uintptr_t offset = (uintptr_t)addr;
+        uint8_t * dest   = (uint8_t *)buf;
+        for (size_t i = 0; i < len && offset + i < EECONFIG_SIZE; i++) {
+            if (write_back_is_dirty(offset + i)) {
+                dest[i] = write_back_data[offset + i];
+            }
+        }
+    }
+#endif
+}
+
+/** \brief eeconfig update block
+ *
+ * Writes a block of eeconfig. With EECONFIG_WRITE_BACK the bytes within EECONFIG_SIZE
+ * are only marked dirty, and committed later by eeconfig_task() or eeconfig_flush().
+ */
+void eeconfig_update_block(const void *buf, void *addr, size_t len) {
+#ifdef EECONFIG_WRITE_BACK
+    uintptr_t      offset = (uintptr_t)addr;
+    const uint8_t *src    = (const uint8_t *)buf;
+    while (len && offset < EECONFIG_SIZE) {
+        write_back_data[offset] = *src++;
+        write_back_dirty[offset / 8] |= 1 << (offset % 8);
+        offset++;
+        len--;
+        write_back_pending = true;
+        write_back_timer   = timer_read32();
+    }
+    if (len) {
+        eeprom_update_block(src, (void *)offset, len);
+    }
+#else
+    eeprom_update_block(buf, addr, len);
+#endif
+}
+
+static uint8_t eeconfig_read_byte(const uint8_t *addr) {
+    uint8_t val;
+    eeconfig_read_block(&val, addr, sizeof(val));
+    return val;
+}
+
+static uint32_t eeconfig_read_dword(const uint32_t *addr) {
+    uint32_t val;
+    eeconfig_read_block(&val, addr, sizeof(val));
+    return val;
+}
+
+static void eeconfig_update_byte(uint8_t *addr, uint8_t val) { eeconfig_update_block(&val, addr, sizeof(val)); }
+
+static void eeconfig_update_dword(uint32_t *addr, uint32_t val) { eeconfig_update_block(&val, addr, sizeof(val)); }
+
 /** \brief eeconfig enable
  *
  * FIXME: needs doc
@@ -43,6 +165,9 @@ __attribute__((weak)) void eeconfig_init_kb(void) {
  * FIXME: needs doc
  */
 void eeconfig_init_quantum(void) {
+#ifdef EECONFIG_WRITE_BACK
+    write_back_discard();
+#endif
 #ifdef STM32_EEPROM_ENABLE
     EEPROM_Erase();
 #endif
@@ -111,6 +236,9 @@ void eeconfig_enable(void) { eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_N
  * FIXME: needs doc
  */
 void eeconfig_disable(void) {
+#ifdef EECONFIG_WRITE_BACK
+    write_back_discard();
+#endif
 #ifdef STM32_EEPROM_ENABLE
     EEPROM_Erase();
 #endif
@@ -152,89 +280,89 @@ bool eeconfig_is_disabled(void) {
  *
  * FIXME: needs doc
  */
-uint8_t eeconfig_read_debug(void) { return eeprom_read_byte(EECONFIG_DEBUG); }
+uint8_t eeconfig_read_debug(void) { return eeconfig_read_byte(EECONFIG_DEBUG); }
 /** \brief eeconfig update debug
  *
  * FIXME: needs doc
  */
-void eeconfig_update_debug(uint8_t val) { eeprom_update_byte(EECONFIG_DEBUG, val); }
+void eeconfig_update_debug(uint8_t val) { eeconfig_update_byte(EECONFIG_DEBUG, val); }
 
 /** \brief eeconfig read default layer
  *
  * FIXME: needs doc
  */
-uint8_t eeconfig_read_default_layer(void) { return eeprom_read_byte(EECONFIG_DEFAULT_LAYER); }
+uint8_t eeconfig_read_default_layer(void) { return eeconfig_read_byte(EECONFIG_DEFAULT_LAYER); }
 /** \brief eeconfig update default layer
  *
  * FIXME: needs doc
  */
-void eeconfig_update_default_layer(uint8_t val) { eeprom_update_byte(EECONFIG_DEFAULT_LAYER, val); }
+void eeconfig_update_default_layer(uint8_t val) { eeconfig_update_byte(EECONFIG_DEFAULT_LAYER, val); }
 
 /** \brief eeconfig read keymap
  *
  * FIXME: needs doc
  */
-uint16_t eeconfig_read_keymap(void) { return (eeprom_read_byte(EECONFIG_KEYMAP_LOWER_BYTE) | (eeprom_read_byte(EECONFIG_KEYMAP_UPPER_BYTE) << 8)); }
+uint16_t eeconfig_read_keymap(void) { return (eeconfig_read_byte(EECONFIG_KEYMAP_LOWER_BYTE) | (eeconfig_read_byte(EECONFIG_KEYMAP_UPPER_BYTE) << 8)); }
 /** \brief eeconfig update keymap
  *
  * FIXME: needs doc
  */
 void eeconfig_update_keymap(uint16_t val) {
-    eeprom_update_byte(EECONFIG_KEYMAP_LOWER_BYTE, val & 0xFF);
-    eeprom_update_byte(EECONFIG_KEYMAP_UPPER_BYTE, (val >> 8) & 0xFF);
+    eeconfig_update_byte(EECONFIG_KEYMAP_LOWER_BYTE, val & 0xFF);
+    eeconfig_update_byte(EECONFIG_KEYMAP_UPPER_BYTE, (val >> 8) & 0xFF);
 }
 
 /** \brief eeconfig read audio
  *
  * FIXME: needs doc
  */
-uint8_t eeconfig_read_audio(void) { return eeprom_read_byte(EECONFIG_AUDIO); }
+uint8_t eeconfig_read_audio(void) { return eeconfig_read_byte(EECONFIG_AUDIO); }
 /** \brief eeconfig update audio
  *
  * FIXME: needs doc
  */
-void eeconfig_update_audio(uint8_t val) { eeprom_update_byte(EECONFIG_AUDIO, val); }
+void eeconfig_update_audio(uint8_t val) { eeconfig_update_byte(EECONFIG_AUDIO, val); }
 
 /** \brief eeconfig read kb
  *
  * FIXME: needs doc
  */
-uint32_t eeconfig_read_kb(void) { return eeprom_read_dword(EECONFIG_KEYBOARD); }
+uint32_t eeconfig_read_kb(void) { return eeconfig_read_dword(EECONFIG_KEYBOARD); }
 /** \brief eeconfig update kb
  *
  * FIXME: needs doc
  */
-void eeconfig_update_kb(uint32_t val) { eeprom_update_dword(EECONFIG_KEYBOARD, val); }
+void eeconfig_update_kb(uint32_t val) { eeconfig_update_dword(EECONFIG_KEYBOARD, val); }
 
 /** \brief eeconfig read user
  *
  * FIXME: needs doc
  */
-uint32_t eeconfig_read_user(void) { return eeprom_read_dword(EECONFIG_USER); }
+uint32_t eeconfig_read_user(void) { return eeconfig_read_dword(EECONFIG_USER); }
 /** \brief eeconfig update user
  *
  * FIXME: needs doc
  */
-void eeconfig_update_user(uint32_t val) { eeprom_update_dword(EECONFIG_USER, val); }
+void eeconfig_update_user(uint32_t val) { eeconfig_update_dword(EECONFIG_USER, val); }
 
 /** \brief eeconfig read haptic
  *
  * FIXME: needs doc
  */
-uint32_t eeconfig_read_haptic(void) { return eeprom_read_dword(EECONFIG_HAPTIC); }
+uint32_t eeconfig_read_haptic(void) { return eeconfig_read_dword(EECONFIG_HAPTIC); }
 /** \brief eeconfig update haptic
  *
  * FIXME: needs doc
  */
-void eeconfig_update_haptic(uint32_t val) { eeprom_update_dword(EECONFIG_HAPTIC, val); }
+void eeconfig_update_haptic(uint32_t val) { eeconfig_update_dword(EECONFIG_HAPTIC, val); }
 
 /** \brief eeconfig read split handedness
  *
  * FIXME: needs doc
  */
-bool eeconfig_read_handedness(void) { return !!eeprom_read_byte(EECONFIG_HANDEDNESS); }
+bool eeconfig_read_handedness(void) { return !!eeconfig_read_byte(EECONFIG_HANDEDNESS); }
 /** \brief eeconfig update split handedness
  *
  * FIXME: needs doc
  */
-void eeconfig_update_handedness(bool val) { eeprom_update_byte(EECONFIG_HANDEDNESS, !!val); }
+void eeconfig_update_handedness(bool val) { eeconfig_update_byte(EECONFIG_HANDEDNESS, !!val); }
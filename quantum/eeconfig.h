@@ -19,6 +19,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifndef EECONFIG_MAGIC_NUMBER
 #    define EECONFIG_MAGIC_NUMBER (uint16_t)0xFEE9  // When changing, decrement this value to avoid future re-init issues
@@ -111,3 +112,17 @@ void     eeconfig_update_haptic(uint32_t val);
 
 bool eeconfig_read_handedness(void);
 void eeconfig_update_handedness(bool val);
+
+void eeconfig_read_block(void *buf, const void *addr, size_t len);
+void eeconfig_update_block(const void *buf, void *addr, size_t len);
+
+#ifdef EECONFIG_WRITE_BACK
+/* Quiet period after the last eeconfig update before the pending changes are committed */
+#    ifndef EECONFIG_WRITE_BACK_DELAY
+#        define EECONFIG_WRITE_BACK_DELAY 2000
+#    endif
+
+bool eeconfig_is_dirty(void);
+void eeconfig_flush(void);
+void eeconfig_task(void);
+#endif
@@ -109,6 +109,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
 #endif
+#include "task_profile.h"
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) { return last_input_modification_time; }
@@ -194,6 +195,18 @@ static inline bool has_ghost_in_row(uint8_t row, matrix_row_t rowdata) {
 
 #endif
 
+/** \brief matrix_row_lowest_bit
+ *
+ * Index of the lowest set bit of a non-zero row.
+ */
+static inline uint8_t matrix_row_lowest_bit(matrix_row_t bits) {
+#if (MATRIX_COLS <= 16)
+    return __builtin_ctz(bits);
+#else
+    return __builtin_ctzl(bits);
+#endif
+}
+
 void disable_jtag(void) {
 // To use PF4-7 (PC2-5 on ATmega32A), disable JTAG by writing JTD bit twice within four cycles.
 #if (defined(__AVR_AT90USB646__) || defined(__AVR_AT90USB647__) || defined(__AVR_AT90USB1286__) || defined(__AVR_AT90USB1287__) || defined(__AVR_ATmega16U4__) || defined(__AVR_ATmega32U4__))
@@ -298,6 +311,12 @@ __attribute__((weak)) void housekeeping_task_user(void) {}
  * Invokes hooks for executing code after QMK is done after each loop iteration.
  */
 void housekeeping_task(void) {
+#ifdef EECONFIG_WRITE_BACK
+    eeconfig_task();
+#endif
+#ifdef STM32_EEPROM_ENABLE
+    EEPROM_Task();
+#endif
     housekeeping_task_kb();
     housekeeping_task_user();
 }
@@ -395,16 +414,21 @@ void keyboard_task(void) {
     static uint8_t      led_status    = 0;
     matrix_row_t        matrix_row    = 0;
     matrix_row_t        matrix_change = 0;
-#ifdef QMK_KEYS_PER_SCAN
+#if defined(QMK_KEYS_PER_SCAN) || defined(QMK_BATCHED_EVENTS)
     uint8_t keys_processed = 0;
 #endif
 #ifdef ENCODER_ENABLE
     bool encoders_changed = false;
 #endif
 
+    TASK_PROFILE_BEGIN(TASK_PROFILE_KEYBOARD_TASK);
+
+    TASK_PROFILE_BEGIN(TASK_PROFILE_MATRIX_SCAN);
     uint8_t matrix_changed = matrix_scan();
+    TASK_PROFILE_END(TASK_PROFILE_MATRIX_SCAN);
     if (matrix_changed) last_matrix_activity_trigger();
 
+    TASK_PROFILE_BEGIN(TASK_PROFILE_ACTION_EXEC);
     for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
         matrix_row    = matrix_get_row(r);
         matrix_change = matrix_row ^ matrix_prev[r];
@@ -415,37 +439,47 @@ void keyboard_task(void) {
             }
 #endif
             if (debug_matrix) matrix_print();
-            matrix_row_t col_mask = 1;
-            for (uint8_t c = 0; c < MATRIX_COLS; c++, col_mask <<= 1) {
-                if (matrix_change & col_mask) {
-                    if (should_process_keypress()) {
-                        action_exec((keyevent_t){
-                            .key = (keypos_t){.row = r, .col = c}, .pressed = (matrix_row & col_mask), .time = (timer_read() | 1) /* time should not be 0 */
-                        });
-                    }
-                    // record a processed key
-                    matrix_prev[r] ^= col_mask;
-
-                    switch_events(r, c, (matrix_row & col_mask));
-
-#ifdef QMK_KEYS_PER_SCAN
-                    // only jump out if we have processed "enough" keys.
-                    if (++keys_processed >= QMK_KEYS_PER_SCAN)
-#endif
-                        // process a key per task call
-                        goto MATRIX_LOOP_END;
+            // walk the changed bits lowest column first, so events keep matrix order
+            while (matrix_change) {
+                uint8_t      c        = matrix_row_lowest_bit(matrix_change);
+                matrix_row_t col_mask = MATRIX_ROW_SHIFTER << c;
+                matrix_change &= matrix_change - 1;
+
+                if (should_process_keypress()) {
+                    action_exec((keyevent_t){
+                        .key = (keypos_t){.row = r, .col = c}, .pressed = (matrix_row & col_mask), .time = (timer_read() | 1) /* time should not be 0 */
+                    });
                 }
+                // record a processed key
+                matrix_prev[r] ^= col_mask;
+
+                switch_events(r, c, (matrix_row & col_mask));
+
+#if defined(QMK_BATCHED_EVENTS)
+                // drain every changed key of this scan before running the other tasks
+                keys_processed = 1;
+#else
+#    ifdef QMK_KEYS_PER_SCAN
+                // only jump out if we have processed "enough" keys.
+                if (++keys_processed >= QMK_KEYS_PER_SCAN)
+#    endif
+                    // process a key per task call
+                    goto MATRIX_LOOP_END;
+#endif
             }
         }
     }
     // call with pseudo tick event when no real key event.
-#ifdef QMK_KEYS_PER_SCAN
+#if defined(QMK_KEYS_PER_SCAN) || defined(QMK_BATCHED_EVENTS)
     // we can get here with some keys processed now.
     if (!keys_processed)
 #endif
         action_exec(TICK);
 
+#ifndef QMK_BATCHED_EVENTS
 MATRIX_LOOP_END:
+#endif
+    TASK_PROFILE_END(TASK_PROFILE_ACTION_EXEC);
 
 #ifdef DEBUG_MATRIX_SCAN_RATE
     matrix_scan_perf_task();
@@ -459,7 +493,9 @@ MATRIX_LOOP_END:
     led_matrix_task();
 #endif
 #ifdef RGB_MATRIX_ENABLE
+    TASK_PROFILE_BEGIN(TASK_PROFILE_RGB_MATRIX);
     rgb_matrix_task();
+    TASK_PROFILE_END(TASK_PROFILE_RGB_MATRIX);
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
@@ -469,7 +505,9 @@ MATRIX_LOOP_END:
 #endif
 
 #ifdef ENCODER_ENABLE
+    TASK_PROFILE_BEGIN(TASK_PROFILE_ENCODER);
     encoders_changed = encoder_read();
+    TASK_PROFILE_END(TASK_PROFILE_ENCODER);
     if (encoders_changed) last_encoder_activity_trigger();
 #endif
 
@@ -478,7 +516,9 @@ MATRIX_LOOP_END:
 #endif
 
 #ifdef OLED_ENABLE
+    TASK_PROFILE_BEGIN(TASK_PROFILE_OLED);
     oled_task();
+    TASK_PROFILE_END(TASK_PROFILE_OLED);
 #    ifndef OLED_DISABLE_TIMEOUT
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
 #        ifdef ENCODER_ENABLE
@@ -527,7 +567,9 @@ MATRIX_LOOP_END:
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
+    TASK_PROFILE_BEGIN(TASK_PROFILE_POINTING_DEVICE);
     pointing_device_task();
+    TASK_PROFILE_END(TASK_PROFILE_POINTING_DEVICE);
 #endif
 
 #ifdef MIDI_ENABLE
@@ -553,6 +595,11 @@ MATRIX_LOOP_END:
         led_status = host_keyboard_leds();
         keyboard_set_leds(led_status);
     }
+
+    TASK_PROFILE_END(TASK_PROFILE_KEYBOARD_TASK);
+#ifdef TASK_PROFILE_ENABLE
+    task_profile_task();
+#endif
 }
 
 /** \brief keyboard set leds
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "matrix.h"
 #include "debounce.h"
 #include "quantum.h"
+#include "task_profile.h"
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
 #    include "split_common/transactions.h"
@@ -252,6 +253,130 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_IDLE_SCAN_SUPPRESSION
+// While no key is down, every row (or column, for ROW2COL) is held selected so that any key press pulls
+// one of the inputs low. A scan then only has to look for that instead of strobing the whole matrix, and
+// on ChibiOS with PAL callbacks the inputs raise an interrupt so even that check is skipped.
+#    if defined(DIRECT_PINS)
+#        define MATRIX_IDLE_INPUTS (ROWS_PER_HAND * MATRIX_COLS)
+static inline pin_t matrix_idle_input(uint8_t index) { return direct_pins[index / MATRIX_COLS][index % MATRIX_COLS]; }
+static void         matrix_idle_select(void) {}
+static void         matrix_idle_unselect(void) {}
+#    elif defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS) && (DIODE_DIRECTION == COL2ROW)
+#        define MATRIX_IDLE_INPUTS (MATRIX_COLS)
+static inline pin_t matrix_idle_input(uint8_t index) { return col_pins[index]; }
+static void         matrix_idle_select(void) {
+    for (uint8_t x = 0; x < ROWS_PER_HAND; x++) {
+        select_row(x);
+    }
+}
+static void matrix_idle_unselect(void) { unselect_rows(); }
+#    elif defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS) && (DIODE_DIRECTION == ROW2COL)
+#        define MATRIX_IDLE_INPUTS (ROWS_PER_HAND)
+static inline pin_t matrix_idle_input(uint8_t index) { return row_pins[index]; }
+static void         matrix_idle_select(void) {
+    for (uint8_t x = 0; x < MATRIX_COLS; x++) {
+        select_col(x);
+    }
+}
+static void matrix_idle_unselect(void) { unselect_cols(); }
+#    else
+#        error MATRIX_IDLE_SCAN_SUPPRESSION requires DIRECT_PINS, or MATRIX_ROW_PINS and MATRIX_COL_PINS
+#    endif
+
+static bool matrix_idle = false;
+
+#    if defined(PROTOCOL_CHIBIOS) && (PAL_USE_CALLBACKS == TRUE)
+static volatile bool matrix_idle_wakeup         = false;
+static bool          matrix_idle_use_interrupts = false;
+
+static void matrix_idle_wakeup_callback(void *arg) { matrix_idle_wakeup = true; }
+
+// Each EXTI line serves one pin number across all ports, so interrupts are only usable when the inputs don't share one,
+// with each other or with the pins other drivers take line events on
+static void matrix_idle_init_interrupts(void) {
+    uint32_t pads = 0;
+#        ifdef SOFT_SERIAL_PIN
+    pads |= 1UL << PAL_PAD(SOFT_SERIAL_PIN);
+#        endif
+#        ifdef PS2_CLOCK
+    pads |= 1UL << PAL_PAD(PS2_CLOCK);
+#        endif
+
+    matrix_idle_use_interrupts = true;
+    for (uint8_t i = 0; i < MATRIX_IDLE_INPUTS; i++) {
+        pin_t pin = matrix_idle_input(i);
+        if (pin == NO_PIN) continue;
+        if (pads & (1UL << PAL_PAD(pin))) {
+            matrix_idle_use_interrupts = false;
+        }
+        pads |= 1UL << PAL_PAD(pin);
+    }
+}
+
+static void matrix_idle_arm(void) {
+    if (!matrix_idle_use_interrupts) return;
+    matrix_idle_wakeup = false;
+    for (uint8_t i = 0; i < MATRIX_IDLE_INPUTS; i++) {
+        pin_t pin = matrix_idle_input(i);
+        if (pin != NO_PIN) {
+            palEnableLineEvent(pin, PAL_EVENT_MODE_BOTH_EDGES);
+            palSetLineCallback(pin, matrix_idle_wakeup_callback, NULL);
+        }
+    }
+}
+
+static void matrix_idle_disarm(void) {
+    if (!matrix_idle_use_interrupts) return;
+    for (uint8_t i = 0; i < MATRIX_IDLE_INPUTS; i++) {
+        pin_t pin = matrix_idle_input(i);
+        if (pin != NO_PIN) {
+            palDisableLineEvent(pin);
+        }
+    }
+}
+#    else
+static void matrix_idle_init_interrupts(void) {}
+static void matrix_idle_arm(void) {}
+static void matrix_idle_disarm(void) {}
+#    endif
+
+static bool matrix_idle_any_input_low(void) {
+    for (uint8_t i = 0; i < MATRIX_IDLE_INPUTS; i++) {
+        if (readMatrixPin(matrix_idle_input(i)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void matrix_idle_enter(void) {
+    matrix_idle_select();
+    matrix_output_select_delay();
+    matrix_idle_arm();
+    // a key that went down while the interrupts were being armed would otherwise go unnoticed
+    matrix_idle = !matrix_idle_any_input_low();
+    if (!matrix_idle) {
+        matrix_idle_disarm();
+        matrix_idle_unselect();
+    }
+}
+
+static void matrix_idle_exit(void) {
+    matrix_idle_disarm();
+    matrix_idle_unselect();
+    matrix_output_unselect_delay(0, true);  // wait for the inputs pulled by held keys to go HIGH
+    matrix_idle = false;
+}
+
+static bool matrix_idle_woken(void) {
+#    if defined(PROTOCOL_CHIBIOS) && (PAL_USE_CALLBACKS == TRUE)
+    if (matrix_idle_use_interrupts) return matrix_idle_wakeup;
+#    endif
+    return matrix_idle_any_input_low();
+}
+#endif  // MATRIX_IDLE_SCAN_SUPPRESSION
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     split_pre_init();
@@ -286,6 +411,9 @@ void matrix_init(void) {
 
     // initialize key pins
     matrix_init_pins();
+#ifdef MATRIX_IDLE_SCAN_SUPPRESSION
+    matrix_idle_init_interrupts();
+#endif
 
     // initialize matrix state: all keys off
     for (uint8_t i = 0; i < MATRIX_ROWS; i++) {
@@ -313,7 +441,10 @@ bool matrix_post_scan(void) {
     bool changed = false;
     if (is_keyboard_master()) {
         matrix_row_t slave_matrix[ROWS_PER_HAND] = {0};
-        if (transport_master_if_connected(matrix + thisHand, slave_matrix)) {
+        TASK_PROFILE_BEGIN(TASK_PROFILE_SPLIT_TRANSPORT);
+        bool connected = transport_master_if_connected(matrix + thisHand, slave_matrix);
+        TASK_PROFILE_END(TASK_PROFILE_SPLIT_TRANSPORT);
+        if (connected) {
             for (int i = 0; i < ROWS_PER_HAND; ++i) {
                 if (matrix[thatHand + i] != slave_matrix[i]) {
                     matrix[thatHand + i] = slave_matrix[i];
@@ -341,9 +472,7 @@ bool matrix_post_scan(void) {
 }
 #endif
 
-uint8_t matrix_scan(void) {
-    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
-
+static void matrix_read(matrix_row_t curr_matrix[]) {
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
     // Set row, read cols
     for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
@@ -355,15 +484,42 @@ uint8_t matrix_scan(void) {
         matrix_read_rows_on_col(curr_matrix, current_col);
     }
 #endif
+}
+
+uint8_t matrix_scan(void) {
+    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
+
+#ifdef MATRIX_IDLE_SCAN_SUPPRESSION
+    // Nothing was down and nothing has moved since, so the matrix is still all zero
+    if (!matrix_idle || matrix_idle_woken()) {
+        if (matrix_idle) matrix_idle_exit();
+        matrix_read(curr_matrix);
+    }
+#else
+    matrix_read(curr_matrix);
+#endif
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
 
+#ifdef MATRIX_IDLE_SCAN_SUPPRESSION
+    if (!matrix_idle) {
+        matrix_row_t any_down = 0;
+        for (uint8_t i = 0; i < ROWS_PER_HAND; i++) {
+            any_down |= curr_matrix[i];
+        }
+        if (!any_down) matrix_idle_enter();
+    }
+#endif
+
+    TASK_PROFILE_BEGIN(TASK_PROFILE_DEBOUNCE);
 #ifdef SPLIT_KEYBOARD
     debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed);
+    TASK_PROFILE_END(TASK_PROFILE_DEBOUNCE);
     changed = (changed || matrix_post_scan());
 #else
     debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+    TASK_PROFILE_END(TASK_PROFILE_DEBOUNCE);
     matrix_scan_quantum();
 #endif
     return (uint8_t)changed;
@@ -4,6 +4,7 @@
 #include "wait.h"
 #include "print.h"
 #include "debug.h"
+#include "task_profile.h"
 
 #ifndef MATRIX_IO_DELAY
 #    define MATRIX_IO_DELAY 30
@@ -112,7 +113,9 @@ __attribute__((weak)) void matrix_init(void) {
 __attribute__((weak)) uint8_t matrix_scan(void) {
     bool changed = matrix_scan_custom(raw_matrix);
 
+    TASK_PROFILE_BEGIN(TASK_PROFILE_DEBOUNCE);
     debounce(raw_matrix, matrix, MATRIX_ROWS, changed);
+    TASK_PROFILE_END(TASK_PROFILE_DEBOUNCE);
 
     matrix_scan_quantum();
     return changed;
@@ -23,19 +23,90 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "debug.h"
 #include "pointing_device.h"
 
+#ifndef POINTING_DEVICE_MOTION_DIVISOR
+#    define POINTING_DEVICE_MOTION_DIVISOR 1
+#endif
+
+#if POINTING_DEVICE_MOTION_DIVISOR < 1
+#    error "POINTING_DEVICE_MOTION_DIVISOR has to be at least 1"
+#endif
+
+#define MOTION_LIMIT ((int32_t)INT16_MAX * POINTING_DEVICE_MOTION_DIVISOR)
+
 static report_mouse_t mouseReport = {};
 
+/* Movement that has not been sent yet. x and y are in sensor counts, so the part below
+ * POINTING_DEVICE_MOTION_DIVISOR is carried over to the next report instead of being lost. */
+static int32_t motion_x = 0;
+static int32_t motion_y = 0;
+static int32_t motion_h = 0;
+static int32_t motion_v = 0;
+
+#ifdef POINTING_DEVICE_REPORT_INTERVAL
+static uint16_t report_timer = 0;
+#endif
+
+static int32_t add_saturated(int32_t motion, int32_t delta, int32_t limit) {
+    motion += delta;
+    return motion > limit ? limit : (motion < -limit ? -limit : motion);
+}
+
+// take as much of the accumulated motion as fits in a report, leaving the rest
+static int8_t take_motion(int32_t *motion, int32_t divisor) {
+    int32_t counts = *motion / divisor;
+    if (counts > 127) counts = 127;
+    if (counts < -127) counts = -127;
+    *motion -= counts * divisor;
+    return counts;
+}
+
 __attribute__((weak)) bool has_mouse_report_changed(report_mouse_t new, report_mouse_t old) { return (new.buttons != old.buttons) || (new.x&& new.x != old.x) || (new.y&& new.y != old.y) || (new.h&& new.h != old.h) || (new.v&& new.v != old.v); }
 
 __attribute__((weak)) void pointing_device_init(void) {
     // initialize device, if that needs to be done.
 }
 
+/** \brief pointing_device_add_motion
+ *
+ * Adds raw sensor counts to the movement of the next report. Can be called as often as the
+ * sensor has data, nothing is lost between two reports; POINTING_DEVICE_MOTION_DIVISOR counts
+ * move the pointer by one unit.
+ */
+void pointing_device_add_motion(int16_t x, int16_t y) {
+    motion_x = add_saturated(motion_x, x, MOTION_LIMIT);
+    motion_y = add_saturated(motion_y, y, MOTION_LIMIT);
+}
+
 __attribute__((weak)) void pointing_device_send(void) {
     static report_mouse_t old_report = {};
 
+    // the movement in the report joins the accumulated motion, which is then sent as far as the report allows
+    motion_x = add_saturated(motion_x, (int32_t)mouseReport.x * POINTING_DEVICE_MOTION_DIVISOR, MOTION_LIMIT);
+    motion_y = add_saturated(motion_y, (int32_t)mouseReport.y * POINTING_DEVICE_MOTION_DIVISOR, MOTION_LIMIT);
+    motion_h = add_saturated(motion_h, mouseReport.h, INT16_MAX);
+    motion_v = add_saturated(motion_v, mouseReport.v, INT16_MAX);
+    mouseReport.x = 0;
+    mouseReport.y = 0;
+    mouseReport.v = 0;
+    mouseReport.h = 0;
+
+#ifdef POINTING_DEVICE_REPORT_INTERVAL
+    // button changes go out at once, movement is held back until the host polls for the next report
+    if (mouseReport.buttons == old_report.buttons && timer_elapsed(report_timer) < POINTING_DEVICE_REPORT_INTERVAL) {
+        return;
+    }
+#endif
+
+    mouseReport.x = take_motion(&motion_x, POINTING_DEVICE_MOTION_DIVISOR);
+    mouseReport.y = take_motion(&motion_y, POINTING_DEVICE_MOTION_DIVISOR);
+    mouseReport.h = take_motion(&motion_h, 1);
+    mouseReport.v = take_motion(&motion_v, 1);
+
     // If you need to do other things, like debugging, this is the place to do it.
     if (has_mouse_report_changed(mouseReport, old_report)) {
+#ifdef POINTING_DEVICE_REPORT_INTERVAL
+        report_timer = timer_read();
+#endif
         host_mouse_send(&mouseReport);
     }
     // send it and 0 it out except for buttons, so those stay until they are explicity over-ridden using update_pointing_device
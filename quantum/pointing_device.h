@@ -27,3 +27,4 @@ void           pointing_device_send(void);
 report_mouse_t pointing_device_get_report(void);
 void           pointing_device_set_report(report_mouse_t newMouseReport);
 bool           has_mouse_report_changed(report_mouse_t new, report_mouse_t old);
+void           pointing_device_add_motion(int16_t x, int16_t y);
@@ -18,6 +18,9 @@
 #include "process_combo.h"
 #include "action_tapping.h"
 
+#ifdef COMBO_KEY_INDEX
+#    include <stdlib.h>
+#endif
 
 #ifdef COMBO_COUNT
 __attribute__((weak)) combo_t  key_combos[COMBO_COUNT];
@@ -70,6 +73,93 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define COMBO_KEY_POS ((keypos_t){.col=254, .row=254})
 
+#ifdef COMBO_KEY_INDEX
+/* Index from keycode to the combos containing it, sorted by keycode and then
+ * combo index, so a key event only visits its own combos, in the same order
+ * as a full scan would. combo_touched has a bit per combo that may hold
+ * partial state, so clear_combos() only visits those. Built on first use;
+ * if the allocation fails every combo is scanned as before. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_key_index_t;
+
+static combo_key_index_t *combo_key_index      = NULL;
+static uint16_t           combo_key_index_size = 0;
+static uint8_t *          combo_touched        = NULL;
+static bool               combo_key_index_done = false;
+
+#    define COMBO_TOUCH(combo_index)                                                           \
+        do {                                                                                   \
+            if (combo_touched) combo_touched[(combo_index) / 8] |= (1 << ((combo_index) % 8)); \
+        } while (0)
+
+static int combo_key_index_compare(const void *a, const void *b) {
+    const combo_key_index_t *entry_a = a;
+    const combo_key_index_t *entry_b = b;
+    if (entry_a->keycode != entry_b->keycode) {
+        return entry_a->keycode < entry_b->keycode ? -1 : 1;
+    }
+    return (int)entry_a->combo_index - (int)entry_b->combo_index;
+}
+
+static void combo_key_index_init(void) {
+    combo_key_index_done = true;
+
+    uint16_t count = 0;
+    for (uint16_t idx = 0; idx < COMBO_LEN; ++idx) {
+        const uint16_t *keys = key_combos[idx].keys;
+        while (pgm_read_word(keys++) != COMBO_END) {
+            count++;
+        }
+    }
+
+    combo_key_index = malloc(count * sizeof(combo_key_index_t));
+    combo_touched   = calloc((COMBO_LEN + 7) / 8, 1);
+    if (!combo_key_index || !combo_touched) {
+        free(combo_key_index);
+        free(combo_touched);
+        combo_key_index = NULL;
+        combo_touched   = NULL;
+        return;
+    }
+
+    count = 0;
+    for (uint16_t idx = 0; idx < COMBO_LEN; ++idx) {
+        const uint16_t *keys = key_combos[idx].keys;
+        uint16_t        key;
+        while ((key = pgm_read_word(keys++)) != COMBO_END) {
+            combo_key_index[count++] = (combo_key_index_t){.keycode = key, .combo_index = idx};
+        }
+    }
+    qsort(combo_key_index, count, sizeof(combo_key_index_t), combo_key_index_compare);
+
+    // a keycode listed twice in one combo must still only visit that combo once
+    combo_key_index_size = 0;
+    for (uint16_t i = 0; i < count; ++i) {
+        if (combo_key_index_size && !combo_key_index_compare(&combo_key_index[combo_key_index_size - 1], &combo_key_index[i])) {
+            continue;
+        }
+        combo_key_index[combo_key_index_size++] = combo_key_index[i];
+    }
+}
+
+/* First index entry for keycode, or combo_key_index_size if it isn't part of any combo. */
+static uint16_t combo_key_index_find(uint16_t keycode) {
+    uint16_t low = 0, high = combo_key_index_size;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_key_index[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+#else
+#    define COMBO_TOUCH(combo_index)
+#endif
 
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
@@ -155,6 +245,23 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term = 0;
+#ifdef COMBO_KEY_INDEX
+    if (combo_touched) {
+        for (uint16_t byte = 0; byte < (COMBO_LEN + 7) / 8; ++byte) {
+            uint8_t touched = combo_touched[byte];
+            for (uint8_t bit = 0; touched; ++bit, touched >>= 1) {
+                if (!(touched & 1)) continue;
+                index = byte * 8 + bit;
+                combo_t *combo = &key_combos[index];
+                if (!COMBO_ACTIVE(combo)) {
+                    RESET_COMBO_STATE(combo);
+                    combo_touched[byte] &= ~(1 << bit);
+                }
+            }
+        }
+        return;
+    }
+#endif
     for (index = 0; index < COMBO_LEN; ++index) {
         combo_t *combo = &key_combos[index];
         if (!COMBO_ACTIVE(combo)) {
@@ -350,6 +457,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
         uint16_t time = _get_combo_term(combo_index, combo);
         if (!COMBO_ACTIVE(combo)) {
             KEY_STATE_DOWN(combo->state, key_index);
+            COMBO_TOUCH(combo_index);
             if (longest_term < time) {
                 longest_term = time;
             }
@@ -481,6 +589,17 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     keycode = keymap_key_to_keycode(COMBO_ONLY_FROM_LAYER, record->event.key);
 #endif
 
+#ifdef COMBO_KEY_INDEX
+    if (!combo_key_index_done) {
+        combo_key_index_init();
+    }
+    if (combo_key_index) {
+        for (uint16_t i = combo_key_index_find(keycode); i < combo_key_index_size && combo_key_index[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_key_index[i].combo_index;
+            is_combo_key |= process_single_combo(&key_combos[idx], keycode, record, idx);
+        }
+    } else
+#endif
     for (uint16_t idx = 0; idx < COMBO_LEN; ++idx) {
         combo_t *combo = &key_combos[idx];
         is_combo_key |= process_single_combo(combo, keycode, record, idx);
@@ -55,6 +55,10 @@ float default_layer_songs[][16][2] = DEFAULT_LAYER_SONGS;
 #    include "process_auto_shift.h"
 #endif
 
+#ifdef STM32_EEPROM_ENABLE
+#    include "eeprom_stm32.h"
+#endif
+
 uint8_t extract_mod_bits(uint16_t code) {
     switch (code) {
         case QK_MODS ... QK_MODS_MAX:
@@ -138,6 +142,12 @@ void reset_keyboard(void) {
 #endif
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
+#endif
+#ifdef EECONFIG_WRITE_BACK
+    eeconfig_flush();
+#endif
+#ifdef STM32_EEPROM_ENABLE
+    EEPROM_Flush();
 #endif
     bootloader_jump();
 }
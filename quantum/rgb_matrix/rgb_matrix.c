@@ -19,7 +19,7 @@
 #include "rgb_matrix.h"
 #include "progmem.h"
 #include "config.h"
-#include "eeprom.h"
+#include "eeconfig.h"
 #include <string.h>
 #include <math.h>
 
@@ -125,6 +125,9 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif  // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_PRECOMPUTED_GEOMETRY
+led_geometry_t g_led_geometry[DRIVER_LED_TOTAL];
+#endif  // RGB_MATRIX_PRECOMPUTED_GEOMETRY
 
 // internals
 static bool            suspend_state     = false;
@@ -148,9 +151,17 @@ static last_hit_t last_hit_buffer;
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
 #endif
 
-void eeconfig_read_rgb_matrix(void) { eeprom_read_block(&rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_matrix_config)); }
+// dirty tracking, the last color handed to the driver for each led
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+static RGB  rgb_matrix_shadow[DRIVER_LED_TOTAL];
+static bool rgb_matrix_any_dirty     = false;
+static bool rgb_matrix_resync        = false;  // the driver may not match the shadow, hand it every led until the next flush
+static bool rgb_matrix_was_suspended = false;
+#endif  // RGB_MATRIX_DIRTY_TRACKING
 
-void eeconfig_update_rgb_matrix(void) { eeprom_update_block(&rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_matrix_config)); }
+void eeconfig_read_rgb_matrix(void) { eeconfig_read_block(&rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_matrix_config)); }
+
+void eeconfig_update_rgb_matrix(void) { eeconfig_update_block(&rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_matrix_config)); }
 
 void eeconfig_update_rgb_matrix_default(void) {
     dprintf("eeconfig_update_rgb_matrix_default\n");
@@ -185,9 +196,35 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
     return led_count;
 }
 
-void rgb_matrix_update_pwm_buffers(void) { rgb_matrix_driver.flush(); }
+void rgb_matrix_update_pwm_buffers(void) {
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    // nothing changed since the last flush, the driver already shows this frame
+    if (!rgb_matrix_any_dirty) return;
+#endif  // RGB_MATRIX_DIRTY_TRACKING
+    rgb_matrix_driver.flush();
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    rgb_matrix_any_dirty = false;
+    rgb_matrix_resync    = false;
+#endif  // RGB_MATRIX_DIRTY_TRACKING
+}
+
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+void rgb_matrix_mark_all_dirty(void) {
+    rgb_matrix_any_dirty = true;
+    rgb_matrix_resync    = true;
+}
+#endif  // RGB_MATRIX_DIRTY_TRACKING
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    if (index < 0 || index >= DRIVER_LED_TOTAL) return;
+    RGB *shadow = &rgb_matrix_shadow[index];
+    if (!rgb_matrix_resync && shadow->r == red && shadow->g == green && shadow->b == blue) return;
+    shadow->r            = red;
+    shadow->g            = green;
+    shadow->b            = blue;
+    rgb_matrix_any_dirty = true;
+#endif  // RGB_MATRIX_DIRTY_TRACKING
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     if (!is_keyboard_left() && index >= k_rgb_matrix_split[0])
         rgb_matrix_driver.set_color(index - k_rgb_matrix_split[0], red, green, blue);
@@ -197,7 +234,7 @@ void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#if (defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)) || defined(RGB_MATRIX_DIRTY_TRACKING)
     for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) rgb_matrix_set_color(i, red, green, blue);
 #else
     rgb_matrix_driver.set_color_all(red, green, blue);
@@ -395,6 +432,9 @@ static void rgb_task_render(uint8_t effect) {
 }
 
 static void rgb_task_flush(uint8_t effect) {
+    // the previous frame is still being sent, try again on the next task run
+    if (rgb_matrix_driver.flush_pending && rgb_matrix_driver.flush_pending()) return;
+
     // update last trackers after the first full render so we can init over several frames
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
@@ -470,8 +510,30 @@ __attribute__((weak)) void rgb_matrix_indicators_advanced_kb(uint8_t led_min, ui
 
 __attribute__((weak)) void rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {}
 
+#ifdef RGB_MATRIX_PRECOMPUTED_GEOMETRY
+// g_led_config and the center never change, so the per led math only needs doing once
+static void rgb_matrix_init_geometry(void) {
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+
+        g_led_geometry[i].dx    = dx;
+        g_led_geometry[i].dy    = dy;
+        g_led_geometry[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_led_geometry[i].angle = atan2_8(dy, dx);
+    }
+}
+#endif  // RGB_MATRIX_PRECOMPUTED_GEOMETRY
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+#ifdef RGB_MATRIX_PRECOMPUTED_GEOMETRY
+    rgb_matrix_init_geometry();
+#endif  // RGB_MATRIX_PRECOMPUTED_GEOMETRY
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    // the led state after power up is unknown, so the first flush is a full one
+    rgb_matrix_mark_all_dirty();
+#endif  // RGB_MATRIX_DIRTY_TRACKING
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -500,6 +562,13 @@ void rgb_matrix_init(void) {
 }
 
 void rgb_matrix_set_suspend_state(bool state) {
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    // the driver may have lost its state while suspended, so send every led again on wake up
+    if (!state && rgb_matrix_was_suspended) {
+        rgb_matrix_mark_all_dirty();
+    }
+    rgb_matrix_was_suspended = state;
+#endif  // RGB_MATRIX_DIRTY_TRACKING
 #ifdef RGB_DISABLE_WHEN_USB_SUSPENDED
     if (state && !suspend_state) {  // only run if turning off, and only once
         rgb_task_render(0);         // turn off all LEDs when suspending
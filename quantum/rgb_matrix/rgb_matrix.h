@@ -100,6 +100,12 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+// Hands every led to the driver again and forces the next flush to go out,
+// for when the driver state was changed behind rgb_matrix's back (e.g. the driver was re-initialized)
+void rgb_matrix_mark_all_dirty(void);
+#endif
+
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
@@ -212,6 +218,8 @@ typedef struct {
     void (*set_color_all)(uint8_t r, uint8_t g, uint8_t b);
     /* Flush any buffered changes to the hardware. */
     void (*flush)(void);
+    /* Optional, for drivers that flush in the background: whether the last flush is still being sent. */
+    bool (*flush_pending)(void);
 } rgb_matrix_driver_t;
 
 extern const rgb_matrix_driver_t rgb_matrix_driver;
@@ -226,3 +234,6 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef RGB_MATRIX_PRECOMPUTED_GEOMETRY
+extern led_geometry_t g_led_geometry[DRIVER_LED_TOTAL];
+#endif
@@ -136,6 +136,9 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .flush         = flush,
     .set_color     = IS31FL3731_set_color,
     .set_color_all = IS31FL3731_set_color_all,
+#        ifdef I2C_ASYNC
+    .flush_pending = i2c_async_busy,
+#        endif
 };
 #    elif defined(IS31FL3733)
 static void flush(void) {
@@ -156,6 +159,9 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .flush = flush,
     .set_color = IS31FL3733_set_color,
     .set_color_all = IS31FL3733_set_color_all,
+#        ifdef I2C_ASYNC
+    .flush_pending = i2c_async_busy,
+#        endif
 };
 #    elif defined(IS31FL3737)
 static void flush(void) {
@@ -170,6 +176,9 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .flush = flush,
     .set_color = IS31FL3737_set_color,
     .set_color_all = IS31FL3737_set_color_all,
+#        ifdef I2C_ASYNC
+    .flush_pending = i2c_async_busy,
+#        endif
 };
 #    else
 static void flush(void) { IS31FL3741_update_pwm_buffers(DRIVER_ADDR_1, DRIVER_ADDR_2); }
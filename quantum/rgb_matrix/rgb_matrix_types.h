@@ -64,6 +64,14 @@ typedef struct PACKED {
     uint8_t y;
 } led_point_t;
 
+// position of an led relative to k_rgb_matrix_center
+typedef struct PACKED {
+    int16_t dx;
+    int16_t dy;
+    uint8_t dist;
+    uint8_t angle;
+} led_geometry_t;
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 #define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
 
@@ -178,7 +178,9 @@ void rgblight_check_config(void) {
 
 uint32_t eeconfig_read_rgblight(void) {
 #ifdef EEPROM_ENABLE
-    return eeprom_read_dword(EECONFIG_RGBLIGHT);
+    uint32_t val;
+    eeconfig_read_block(&val, EECONFIG_RGBLIGHT, sizeof(val));
+    return val;
 #else
     return 0;
 #endif
@@ -187,7 +189,7 @@ uint32_t eeconfig_read_rgblight(void) {
 void eeconfig_update_rgblight(uint32_t val) {
 #ifdef EEPROM_ENABLE
     rgblight_check_config();
-    eeprom_update_dword(EECONFIG_RGBLIGHT, val);
+    eeconfig_update_block(&val, EECONFIG_RGBLIGHT, sizeof(val));
 #endif
 }
 
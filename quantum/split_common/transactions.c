@@ -53,6 +53,9 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
 
 ////////////////////////////////////////////////////
 // Helpers
+//
+// The per-feature master handlers below are static inline so they drop out quietly when
+// SPLIT_TRANSACTION_BATCHING replaces them with batch_handlers_master().
 
 static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const char *prefix, bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])) {
     int num_retries = is_transport_connected() ? 10 : 1;
@@ -114,7 +117,7 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
-static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static inline bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0};  // last successfully-read matrix, so we can replicate if there are checksum errors
     matrix_row_t        temp_matrix[(MATRIX_ROWS) / 2];        // holding area while we test whether or not checksum is correct
@@ -147,7 +150,7 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
 
 #ifdef SPLIT_TRANSPORT_MIRROR
 
-static bool master_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static inline bool master_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update = 0;
     return send_if_data_mismatch(PUT_MASTER_MATRIX, &last_update, master_matrix, split_shmem->mmatrix.matrix, sizeof(split_shmem->mmatrix.matrix));
 }
@@ -174,7 +177,7 @@ static void master_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_ro
 
 #ifdef ENCODER_ENABLE
 
-static bool encoder_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static inline bool encoder_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update = 0;
     uint8_t         temp_state[NUMBER_OF_ENCODERS];
 
@@ -213,7 +216,7 @@ static void encoder_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sl
 
 #ifndef DISABLE_SYNC_TIMER
 
-static bool sync_timer_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static inline bool sync_timer_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update = 0;
 
     bool okay = true;
@@ -252,7 +255,7 @@ static void sync_timer_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
 
-static bool layer_state_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static inline bool layer_state_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_layer_state_update         = 0;
     static uint32_t last_default_layer_state_update = 0;
 
@@ -289,7 +292,7 @@ static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #ifdef SPLIT_LED_STATE_ENABLE
 
-static bool led_state_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static inline bool led_state_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update = 0;
     uint8_t         led_state   = host_keyboard_leds();
     return send_if_data_mismatch(PUT_LED_STATE, &last_update, &led_state, &split_shmem->led_state, sizeof(led_state));
@@ -317,7 +320,7 @@ static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #ifdef SPLIT_MODS_ENABLE
 
-static bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static inline bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t   last_update    = 0;
     bool              mods_need_sync = timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS;
     split_mods_sync_t new_mods;
@@ -374,7 +377,7 @@ static void mods_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
 
 #ifdef BACKLIGHT_ENABLE
 
-static bool backlight_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static inline bool backlight_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update = 0;
     uint8_t         level       = is_backlight_enabled() ? get_backlight_level() : 0;
     return send_if_condition(PUT_BACKLIGHT, &last_update, (level != split_shmem->backlight_level), &level, sizeof(level));
@@ -399,7 +402,7 @@ static void backlight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
 
-static bool rgblight_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static inline bool rgblight_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update = 0;
     rgblight_syncinfo_t rgblight_sync;
     rgblight_get_syncinfo(&rgblight_sync);
@@ -436,7 +439,7 @@ static void rgblight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 
 #if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
-static bool led_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static inline bool led_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t   last_update = 0;
     led_matrix_sync_t led_matrix_sync;
     memcpy(&led_matrix_sync.led_matrix, &led_matrix_eeconfig, sizeof(led_eeconfig_t));
@@ -466,7 +469,7 @@ static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
-static bool rgb_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static inline bool rgb_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t   last_update = 0;
     rgb_matrix_sync_t rgb_matrix_sync;
     memcpy(&rgb_matrix_sync.rgb_matrix, &rgb_matrix_config, sizeof(rgb_config_t));
@@ -496,7 +499,7 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
 
-static bool wpm_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static inline bool wpm_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update = 0;
     uint8_t         current_wpm = get_current_wpm();
     return send_if_condition(PUT_WPM, &last_update, (current_wpm != split_shmem->current_wpm), &current_wpm, sizeof(current_wpm));
@@ -521,7 +524,7 @@ static void wpm_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_
 
 #if defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
 
-static bool oled_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static inline bool oled_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update        = 0;
     bool            current_oled_state = is_oled_on();
     return send_if_condition(PUT_OLED, &last_update, (current_oled_state != split_shmem->current_oled_state), &current_oled_state, sizeof(current_oled_state));
@@ -552,7 +555,7 @@ static void oled_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
 
 #if defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
 
-static bool st7565_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static inline bool st7565_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t last_update          = 0;
     bool            current_st7565_state = st7565_is_on();
     return send_if_condition(PUT_ST7565, &last_update, (current_st7565_state != split_shmem->current_st7565_state), &current_st7565_state, sizeof(current_st7565_state));
@@ -578,6 +581,186 @@ static void st7565_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
 
 #endif  // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
 
+////////////////////////////////////////////////////
+// Batched state
+//
+// Replaces the individual transactions above with a single round-trip per scan: the master sends every field
+// that changed since the last successful exchange, flagged in a presence bitmask, and the slave answers with its
+// matrix and encoder state. The slave applies the fields from its transaction callback into the same split_shmem
+// locations the individual transactions would have written, so the slave handlers above work unchanged.
+
+#ifdef SPLIT_TRANSACTION_BATCHING
+
+#    define BATCH_STAGE_IF(bit, condition) \
+        if (force_sync || (condition)) request.present |= (bit)
+#    define BATCH_STAGE(bit, member) BATCH_STAGE_IF(bit, memcmp(&request.member, &last_sent.member, sizeof(request.member)) != 0)
+#    define BATCH_APPLY(bit, member) \
+        if (request->present & (bit)) memcpy(&split_shmem->member, &request->member, sizeof(request->member))
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t              last_update                    = 0;
+    static split_batch_request_t last_sent                      = {0};  // state the slave has acknowledged
+    static matrix_row_t          last_matrix[(MATRIX_ROWS) / 2] = {0};  // last successfully-read matrix, so we can replicate if there are checksum errors
+    split_batch_request_t        request                        = {0};
+    split_batch_response_t       response;
+    bool                         force_sync = timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS;
+
+#    ifdef SPLIT_TRANSPORT_MIRROR
+    memcpy(request.mmatrix.matrix, master_matrix, sizeof(request.mmatrix.matrix));
+    BATCH_STAGE(SPLIT_BATCH_MASTER_MATRIX, mmatrix);
+#    endif  // SPLIT_TRANSPORT_MIRROR
+
+#    ifndef DISABLE_SYNC_TIMER
+    request.sync_timer = sync_timer_read32() + SYNC_TIMER_OFFSET;
+    BATCH_STAGE_IF(SPLIT_BATCH_SYNC_TIMER, false);
+#    endif  // DISABLE_SYNC_TIMER
+
+#    if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+    request.layers.layer_state         = layer_state;
+    request.layers.default_layer_state = default_layer_state;
+    BATCH_STAGE(SPLIT_BATCH_LAYERS, layers);
+#    endif  // !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+
+#    ifdef SPLIT_LED_STATE_ENABLE
+    request.led_state = host_keyboard_leds();
+    BATCH_STAGE(SPLIT_BATCH_LED_STATE, led_state);
+#    endif  // SPLIT_LED_STATE_ENABLE
+
+#    ifdef SPLIT_MODS_ENABLE
+    request.mods.real_mods = get_mods();
+    request.mods.weak_mods = get_weak_mods();
+#        ifndef NO_ACTION_ONESHOT
+    request.mods.oneshot_mods = get_oneshot_mods();
+#        endif  // NO_ACTION_ONESHOT
+    BATCH_STAGE(SPLIT_BATCH_MODS, mods);
+#    endif  // SPLIT_MODS_ENABLE
+
+#    ifdef BACKLIGHT_ENABLE
+    request.backlight_level = is_backlight_enabled() ? get_backlight_level() : 0;
+    BATCH_STAGE(SPLIT_BATCH_BACKLIGHT, backlight_level);
+#    endif  // BACKLIGHT_ENABLE
+
+#    if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    rgblight_get_syncinfo(&request.rgblight_sync);
+    BATCH_STAGE_IF(SPLIT_BATCH_RGBLIGHT, request.rgblight_sync.status.change_flags != 0);
+#    endif  // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+
+#    if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+    memcpy(&request.led_matrix_sync.led_matrix, &led_matrix_eeconfig, sizeof(led_eeconfig_t));
+    request.led_matrix_sync.led_suspend_state = led_matrix_get_suspend_state();
+    BATCH_STAGE(SPLIT_BATCH_LED_MATRIX, led_matrix_sync);
+#    endif  // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+
+#    if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+    memcpy(&request.rgb_matrix_sync.rgb_matrix, &rgb_matrix_config, sizeof(rgb_config_t));
+    request.rgb_matrix_sync.rgb_suspend_state = rgb_matrix_get_suspend_state();
+    BATCH_STAGE(SPLIT_BATCH_RGB_MATRIX, rgb_matrix_sync);
+#    endif  // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+
+#    if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
+    request.current_wpm = get_current_wpm();
+    BATCH_STAGE(SPLIT_BATCH_WPM, current_wpm);
+#    endif  // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
+
+#    if defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
+    request.current_oled_state = is_oled_on();
+    BATCH_STAGE(SPLIT_BATCH_OLED, current_oled_state);
+#    endif  // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
+
+#    if defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
+    request.current_st7565_state = st7565_is_on();
+    BATCH_STAGE(SPLIT_BATCH_ST7565, current_st7565_state);
+#    endif  // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
+
+    bool okay = transport_execute_transaction(EXCHANGE_BATCH, &request, sizeof(request), &response, sizeof(response));
+    if (okay) {
+        memcpy(&last_sent, &request, sizeof(request));
+        if (force_sync) {
+            last_update = timer_read32();
+        }
+#    if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+        if (request.present & SPLIT_BATCH_RGBLIGHT) {
+            rgblight_clear_change_flags();
+        }
+#    endif  // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+
+        okay &= response.smatrix.checksum == crc8(response.smatrix.matrix, sizeof(response.smatrix.matrix));
+        if (okay) {
+            // Checksum matches the received data, save as the last matrix state
+            memcpy(last_matrix, response.smatrix.matrix, sizeof(last_matrix));
+        }
+#    ifdef ENCODER_ENABLE
+        if (response.encoders.checksum == crc8(response.encoders.state, sizeof(response.encoders.state))) {
+            encoder_update_raw(response.encoders.state);
+        } else {
+            okay = false;
+        }
+#    endif  // ENCODER_ENABLE
+    }
+    // Copy out the last-known-good matrix state to the slave matrix
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    return okay;
+}
+
+static void batch_slave_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const split_batch_request_t *request = &split_shmem->batch_request;
+
+#    ifdef SPLIT_TRANSPORT_MIRROR
+    BATCH_APPLY(SPLIT_BATCH_MASTER_MATRIX, mmatrix);
+#    endif  // SPLIT_TRANSPORT_MIRROR
+#    ifndef DISABLE_SYNC_TIMER
+    BATCH_APPLY(SPLIT_BATCH_SYNC_TIMER, sync_timer);
+#    endif  // DISABLE_SYNC_TIMER
+#    if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+    BATCH_APPLY(SPLIT_BATCH_LAYERS, layers);
+#    endif  // !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+#    ifdef SPLIT_LED_STATE_ENABLE
+    BATCH_APPLY(SPLIT_BATCH_LED_STATE, led_state);
+#    endif  // SPLIT_LED_STATE_ENABLE
+#    ifdef SPLIT_MODS_ENABLE
+    BATCH_APPLY(SPLIT_BATCH_MODS, mods);
+#    endif  // SPLIT_MODS_ENABLE
+#    ifdef BACKLIGHT_ENABLE
+    BATCH_APPLY(SPLIT_BATCH_BACKLIGHT, backlight_level);
+#    endif  // BACKLIGHT_ENABLE
+#    if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    BATCH_APPLY(SPLIT_BATCH_RGBLIGHT, rgblight_sync);
+#    endif  // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+#    if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+    BATCH_APPLY(SPLIT_BATCH_LED_MATRIX, led_matrix_sync);
+#    endif  // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+#    if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+    BATCH_APPLY(SPLIT_BATCH_RGB_MATRIX, rgb_matrix_sync);
+#    endif  // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#    if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
+    BATCH_APPLY(SPLIT_BATCH_WPM, current_wpm);
+#    endif  // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
+#    if defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
+    BATCH_APPLY(SPLIT_BATCH_OLED, current_oled_state);
+#    endif  // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
+#    if defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
+    BATCH_APPLY(SPLIT_BATCH_ST7565, current_st7565_state);
+#    endif  // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
+
+    // Answer with the slave's current matrix and encoder state, as prepared by the slave handlers
+    memcpy(&split_shmem->batch_response.smatrix, &split_shmem->smatrix, sizeof(split_shmem->smatrix));
+#    ifdef ENCODER_ENABLE
+    memcpy(&split_shmem->batch_response.encoders, &split_shmem->encoders, sizeof(split_shmem->encoders));
+#    endif  // ENCODER_ENABLE
+}
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_MASTER() TRANSACTION_HANDLER_MASTER(batch)
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [EXCHANGE_BATCH] = { &dummy, sizeof_member(split_shared_memory_t, batch_request), offsetof(split_shared_memory_t, batch_request), sizeof_member(split_shared_memory_t, batch_response), offsetof(split_shared_memory_t, batch_response), batch_slave_callback },
+// clang-format on
+
+#else  // SPLIT_TRANSACTION_BATCHING
+
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif  // SPLIT_TRANSACTION_BATCHING
+
 ////////////////////////////////////////////////////
 
 uint8_t                  dummy;
@@ -604,6 +787,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_WPM_REGISTRATIONS
     TRANSACTIONS_OLED_REGISTRATIONS
     TRANSACTIONS_ST7565_REGISTRATIONS
+    TRANSACTIONS_BATCH_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -615,6 +799,9 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 };
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSACTION_BATCHING
+    TRANSACTIONS_BATCH_MASTER();
+#else   // SPLIT_TRANSACTION_BATCHING
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -629,7 +816,8 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_WPM_MASTER();
     TRANSACTIONS_OLED_MASTER();
     TRANSACTIONS_ST7565_MASTER();
-    return true;
+#endif  // SPLIT_TRANSACTION_BATCHING
+    return transport_flush_transactions();
 }
 
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -696,7 +884,8 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
     if (!transport_read(GET_RPC_RESP_DATA, target2initiator_buffer, target2initiator_buffer_size)) {
         return false;
     }
-    return true;
+    // Without response data the writes above may still be in flight
+    return transport_flush_transactions();
 }
 
 void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
@@ -82,6 +82,8 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+bool transport_flush_transactions(void) { return true; }
+
 #else  // USE_I2C
 
 #    include "serial.h"
@@ -99,6 +101,13 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
         memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
     }
 
+#    ifdef SERIAL_USART_PIPELINE
+    // Nothing to wait for, the reply is read along with the next transaction that needs one
+    if (target2initiator_length == 0) {
+        return soft_serial_transaction_queue(id) == TRANSACTION_END;
+    }
+#    endif  // SERIAL_USART_PIPELINE
+
     if (soft_serial_transaction(id) != TRANSACTION_END) {
         return false;
     }
@@ -111,6 +120,12 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SERIAL_USART_PIPELINE
+bool transport_flush_transactions(void) { return soft_serial_transaction_flush() == TRANSACTION_END; }
+#    else
+bool transport_flush_transactions(void) { return true; }
+#    endif  // SERIAL_USART_PIPELINE
+
 #endif  // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) { return transactions_master(master_matrix, slave_matrix); }
@@ -40,6 +40,9 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+// transactions without a reply may complete later, returns false if any of them failed since the last call
+bool transport_flush_transactions(void);
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #    define NUMBER_OF_ENCODERS (sizeof((pin_t[])ENCODERS_PAD_A) / sizeof(pin_t))
@@ -114,6 +117,87 @@ typedef struct _rpc_sync_info_t {
 } rpc_sync_info_t;
 #endif  // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+#ifdef SPLIT_TRANSACTION_BATCHING
+// Presence bits for the fields carried by a batched transaction
+enum split_batch_fields {
+    SPLIT_BATCH_MASTER_MATRIX = (1 << 0),
+    SPLIT_BATCH_SYNC_TIMER    = (1 << 1),
+    SPLIT_BATCH_LAYERS        = (1 << 2),
+    SPLIT_BATCH_LED_STATE     = (1 << 3),
+    SPLIT_BATCH_MODS          = (1 << 4),
+    SPLIT_BATCH_BACKLIGHT     = (1 << 5),
+    SPLIT_BATCH_RGBLIGHT      = (1 << 6),
+    SPLIT_BATCH_LED_MATRIX    = (1 << 7),
+    SPLIT_BATCH_RGB_MATRIX    = (1 << 8),
+    SPLIT_BATCH_WPM           = (1 << 9),
+    SPLIT_BATCH_OLED          = (1 << 10),
+    SPLIT_BATCH_ST7565        = (1 << 11),
+};
+
+// Master to slave half of a batched transaction, only the fields flagged in
+// `present` are applied by the slave. Field names match split_shared_memory_t.
+typedef struct _split_batch_request_t {
+    uint16_t present;
+
+#    ifdef SPLIT_TRANSPORT_MIRROR
+    split_master_matrix_sync_t mmatrix;
+#    endif  // SPLIT_TRANSPORT_MIRROR
+
+#    ifndef DISABLE_SYNC_TIMER
+    uint32_t sync_timer;
+#    endif  // DISABLE_SYNC_TIMER
+
+#    if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+    split_layers_sync_t layers;
+#    endif  // !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+
+#    ifdef SPLIT_LED_STATE_ENABLE
+    uint8_t led_state;
+#    endif  // SPLIT_LED_STATE_ENABLE
+
+#    ifdef SPLIT_MODS_ENABLE
+    split_mods_sync_t mods;
+#    endif  // SPLIT_MODS_ENABLE
+
+#    ifdef BACKLIGHT_ENABLE
+    uint8_t backlight_level;
+#    endif  // BACKLIGHT_ENABLE
+
+#    if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    rgblight_syncinfo_t rgblight_sync;
+#    endif  // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+
+#    if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+    led_matrix_sync_t led_matrix_sync;
+#    endif  // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+
+#    if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+    rgb_matrix_sync_t rgb_matrix_sync;
+#    endif  // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+
+#    if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
+    uint8_t current_wpm;
+#    endif  // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
+
+#    if defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
+    uint8_t current_oled_state;
+#    endif  // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
+
+#    if defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
+    uint8_t current_st7565_state;
+#    endif  // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
+} split_batch_request_t;
+
+// Slave to master half of a batched transaction, filled in by the slave while the transaction is running
+typedef struct _split_batch_response_t {
+    split_slave_matrix_sync_t smatrix;
+
+#    ifdef ENCODER_ENABLE
+    split_slave_encoder_sync_t encoders;
+#    endif  // ENCODER_ENABLE
+} split_batch_response_t;
+#endif  // SPLIT_TRANSACTION_BATCHING
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -173,6 +257,11 @@ typedef struct _split_shared_memory_t {
     uint8_t current_st7565_state;
 #endif  // ST7565_ENABLE(OLED_ENABLE) && defined(SPLIT_ST7565_ENABLE)
 
+#ifdef SPLIT_TRANSACTION_BATCHING
+    split_batch_request_t  batch_request;
+    split_batch_response_t batch_response;
+#endif  // SPLIT_TRANSACTION_BATCHING
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     rpc_sync_info_t rpc_info;
     uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
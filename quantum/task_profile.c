@@ -0,0 +1,195 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "task_profile.h"
+#include "timer.h"
+#include "print.h"
+#include "util.h"
+
+#if defined(__AVR__)
+#    include <util/atomic.h>
+#    include "timer_avr.h"
+// timer0 compare match flag, set while the millisecond interrupt is pending
+#    if defined(__AVR_ATmega32A__)
+#        define TIMER_RAW_OVERFLOW (TIFR & _BV(OCF0))
+#    elif defined(__AVR_ATtiny85__)
+#        define TIMER_RAW_OVERFLOW (TIFR & _BV(OCF0A))
+#    else
+#        define TIMER_RAW_OVERFLOW (TIFR0 & _BV(OCF0A))
+#    endif
+#elif defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#endif
+
+#if (TASK_PROFILE_BUCKETS < 2) || (TASK_PROFILE_BUCKETS > 33)
+#    error "TASK_PROFILE_BUCKETS must be between 2 and 33"
+#endif
+
+typedef struct {
+    uint32_t count;
+    uint32_t sum;
+    uint32_t min;
+    uint32_t max;
+    uint16_t buckets[TASK_PROFILE_BUCKETS];
+} task_profile_entry_t;
+
+static task_profile_entry_t profile[TASK_PROFILE_STAGE_COUNT];
+
+#if TASK_PROFILE_PRINT_INTERVAL > 0
+static uint32_t profile_timer = 0;
+#endif
+
+/** \brief task_profile_read_ticks
+ *
+ * Free running counter used to time the stages, as fine grained as the platform allows:
+ * the timer0 count on AVR, the cycle counter on ChibiOS ports with realtime counter
+ * support, and the millisecond timer everywhere else.
+ */
+__attribute__((weak)) uint32_t task_profile_read_ticks(void) {
+#if defined(__AVR__)
+    uint32_t ms;
+    uint8_t  raw;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms  = timer_count;
+        raw = TIMER_RAW;
+        // the count has wrapped, but the interrupt that advances timer_count has not run yet
+        if (TIMER_RAW_OVERFLOW && raw < TIMER_RAW_TOP / 2) {
+            ms++;
+        }
+    }
+    return ms * (TIMER_RAW_TOP + 1) + raw;
+#elif defined(PROTOCOL_CHIBIOS) && (PORT_SUPPORTS_RT == TRUE) && defined(STM32_SYSCLK)
+    return chSysGetRealtimeCounterX();
+#else
+    return timer_read32();
+#endif
+}
+
+/** \brief task_profile_ticks_per_ms
+ *
+ * Resolution of task_profile_read_ticks(), for converting the statistics to time.
+ */
+__attribute__((weak)) uint32_t task_profile_ticks_per_ms(void) {
+#if defined(__AVR__)
+    return TIMER_RAW_TOP + 1;
+#elif defined(PROTOCOL_CHIBIOS) && (PORT_SUPPORTS_RT == TRUE) && defined(STM32_SYSCLK)
+    return STM32_SYSCLK / 1000;
+#else
+    return 1;
+#endif
+}
+
+static uint8_t bucket_for(uint32_t ticks) {
+    uint8_t bucket = ticks ? biton32(ticks) + 1 : 0;
+    return bucket < TASK_PROFILE_BUCKETS ? bucket : TASK_PROFILE_BUCKETS - 1;
+}
+
+// Halve the history of a stage so its counters keep room, without losing its shape
+static void decay_entry(task_profile_entry_t *entry) {
+    entry->count >>= 1;
+    entry->sum >>= 1;
+    for (uint8_t i = 0; i < TASK_PROFILE_BUCKETS; i++) {
+        entry->buckets[i] >>= 1;
+    }
+}
+
+void task_profile_record(task_profile_stage_t stage, uint32_t ticks) {
+    if (stage >= TASK_PROFILE_STAGE_COUNT) return;
+
+    task_profile_entry_t *entry  = &profile[stage];
+    uint8_t               bucket = bucket_for(ticks);
+
+    if (entry->buckets[bucket] == UINT16_MAX || entry->sum > UINT32_MAX - ticks) {
+        decay_entry(entry);
+    }
+
+    if (entry->count == 0 || ticks < entry->min) entry->min = ticks;
+    if (ticks > entry->max) entry->max = ticks;
+    entry->count++;
+    entry->sum += ticks;
+    entry->buckets[bucket]++;
+}
+
+bool task_profile_get_stats(task_profile_stage_t stage, task_profile_stats_t *stats) {
+    if (stage >= TASK_PROFILE_STAGE_COUNT || !stats) return false;
+
+    const task_profile_entry_t *entry = &profile[stage];
+    memset(stats, 0, sizeof(task_profile_stats_t));
+    if (entry->count == 0) return false;
+
+    uint32_t samples = 0;
+    for (uint8_t i = 0; i < TASK_PROFILE_BUCKETS; i++) {
+        samples += entry->buckets[i];
+    }
+
+    // the histogram only knows bucket bounds, so report the bound the 99th percentile falls under
+    uint32_t target = samples - samples / 100;
+    uint32_t seen   = 0;
+    stats->p99      = entry->max;
+    for (uint8_t i = 0; i < TASK_PROFILE_BUCKETS - 1; i++) {
+        seen += entry->buckets[i];
+        if (seen >= target) {
+            uint32_t bound = i ? ((uint32_t)1 << i) - 1 : 0;
+            if (bound < stats->p99) stats->p99 = bound;
+            break;
+        }
+    }
+
+    stats->count = entry->count;
+    stats->min   = entry->min;
+    stats->max   = entry->max;
+    stats->avg   = entry->sum / entry->count;
+    return true;
+}
+
+void task_profile_reset(void) { memset(profile, 0, sizeof(profile)); }
+
+void task_profile_print(void) {
+    __attribute__((unused)) static const char *const names[TASK_PROFILE_STAGE_COUNT] = {
+        [TASK_PROFILE_KEYBOARD_TASK]   = "keyboard_task",
+        [TASK_PROFILE_MATRIX_SCAN]     = "matrix_scan",
+        [TASK_PROFILE_DEBOUNCE]        = "debounce",
+        [TASK_PROFILE_SPLIT_TRANSPORT] = "split_transport",
+        [TASK_PROFILE_ACTION_EXEC]     = "action_exec",
+        [TASK_PROFILE_RGB_MATRIX]      = "rgb_matrix_task",
+        [TASK_PROFILE_OLED]            = "oled_task",
+        [TASK_PROFILE_ENCODER]         = "encoder_read",
+        [TASK_PROFILE_POINTING_DEVICE] = "pointing_device",
+    };
+    task_profile_stats_t stats;
+
+    uprintf("task profile (%lu ticks/ms):\n", task_profile_ticks_per_ms());
+    for (uint8_t i = 0; i < TASK_PROFILE_STAGE_COUNT; i++) {
+        if (task_profile_get_stats(i, &stats)) {
+            uprintf("  %s: n=%lu min=%lu avg=%lu p99<=%lu max=%lu\n", names[i], stats.count, stats.min, stats.avg, stats.p99, stats.max);
+        }
+    }
+}
+
+/** \brief task_profile_task
+ *
+ * Prints and restarts the statistics every TASK_PROFILE_PRINT_INTERVAL milliseconds.
+ */
+void task_profile_task(void) {
+#if TASK_PROFILE_PRINT_INTERVAL > 0
+    if (timer_elapsed32(profile_timer) > TASK_PROFILE_PRINT_INTERVAL) {
+        task_profile_print();
+        task_profile_reset();
+        profile_timer = timer_read32();
+    }
+#endif
+}
@@ -0,0 +1,73 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Stages of keyboard_task that are timed. Stages may nest: matrix_scan
+ * includes debounce and, on split keyboards, the split transport. */
+typedef enum {
+    TASK_PROFILE_KEYBOARD_TASK,
+    TASK_PROFILE_MATRIX_SCAN,
+    TASK_PROFILE_DEBOUNCE,
+    TASK_PROFILE_SPLIT_TRANSPORT,
+    TASK_PROFILE_ACTION_EXEC,
+    TASK_PROFILE_RGB_MATRIX,
+    TASK_PROFILE_OLED,
+    TASK_PROFILE_ENCODER,
+    TASK_PROFILE_POINTING_DEVICE,
+    TASK_PROFILE_STAGE_COUNT
+} task_profile_stage_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t avg;
+    uint32_t p99; /* upper bound of the histogram bucket holding the 99th percentile */
+} task_profile_stats_t;
+
+/* Number of log2 histogram buckets kept per stage, bucket n holds samples below 2^n ticks */
+#ifndef TASK_PROFILE_BUCKETS
+#    define TASK_PROFILE_BUCKETS 24
+#endif
+
+/* How often task_profile_task() prints the statistics to the console, 0 disables printing */
+#ifndef TASK_PROFILE_PRINT_INTERVAL
+#    define TASK_PROFILE_PRINT_INTERVAL 5000
+#endif
+
+#ifdef TASK_PROFILE_ENABLE
+
+uint32_t task_profile_read_ticks(void);
+uint32_t task_profile_ticks_per_ms(void);
+void     task_profile_record(task_profile_stage_t stage, uint32_t ticks);
+bool     task_profile_get_stats(task_profile_stage_t stage, task_profile_stats_t *stats);
+void     task_profile_reset(void);
+void     task_profile_print(void);
+void     task_profile_task(void);
+
+#    define TASK_PROFILE_BEGIN(stage) uint32_t task_profile_start_##stage = task_profile_read_ticks()
+#    define TASK_PROFILE_END(stage) task_profile_record(stage, task_profile_read_ticks() - task_profile_start_##stage)
+
+#else
+
+#    define TASK_PROFILE_BEGIN(stage)
+#    define TASK_PROFILE_END(stage)
+
+#endif
@@ -1,7 +1,6 @@
 #include "velocikey.h"
 #include "timer.h"
 #include "eeconfig.h"
-#include "eeprom.h"
 
 #ifndef MIN
 #    define MIN(a, b) (((a) < (b)) ? (a) : (b))
@@ -13,13 +12,15 @@
 #define TYPING_SPEED_MAX_VALUE 200
 uint8_t typing_speed = 0;
 
-bool velocikey_enabled(void) { return eeprom_read_byte(EECONFIG_VELOCIKEY) == 1; }
+bool velocikey_enabled(void) {
+    uint8_t val;
+    eeconfig_read_block(&val, EECONFIG_VELOCIKEY, sizeof(val));
+    return val == 1;
+}
 
 void velocikey_toggle(void) {
-    if (velocikey_enabled())
-        eeprom_update_byte(EECONFIG_VELOCIKEY, 0);
-    else
-        eeprom_update_byte(EECONFIG_VELOCIKEY, 1);
+    uint8_t val = velocikey_enabled() ? 0 : 1;
+    eeconfig_update_block(&val, EECONFIG_VELOCIKEY, sizeof(val));
 }
 
 void velocikey_accelerate(void) {
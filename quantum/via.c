@@ -47,6 +47,7 @@
 #include "tmk_core/common/eeprom.h"
 #include "version.h"  // for QMK_BUILDDATE used in EEPROM magic
 #include "via_ensure_keycode.h"
+#include <string.h>
 
 // Forward declare some helpers.
 #if defined(VIA_QMK_BACKLIGHT_ENABLE)
@@ -180,6 +181,142 @@ bool process_record_via(uint16_t keycode, keyrecord_t *record) {
     return true;
 }
 
+#ifdef VIA_BULK_TRANSFER
+// Transfer in progress; a write is waiting for data packets while remaining > 0,
+// a read is sent once the response to id_bulk_transfer is out.
+static struct {
+    uint8_t  direction;
+    uint8_t  target;
+    uint16_t offset;
+    uint16_t remaining;
+    uint16_t crc;
+    uint16_t expected_crc;
+    uint16_t last_packet;
+} via_bulk = {0};
+
+static uint16_t via_bulk_crc16(uint16_t crc, const uint8_t *data, uint16_t size) {
+    while (size--) {
+        crc ^= (uint16_t)*data++ << 8;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint16_t via_bulk_target_size(uint8_t target) {
+    switch (target) {
+        case id_bulk_dynamic_keymap:
+            return dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+        case id_bulk_dynamic_keymap_macro:
+            return dynamic_keymap_macro_get_buffer_size();
+        default:
+            return 0;
+    }
+}
+
+static void via_bulk_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    if (via_bulk.target == id_bulk_dynamic_keymap) {
+        dynamic_keymap_get_buffer(offset, size, data);
+    } else {
+        dynamic_keymap_macro_get_buffer(offset, size, data);
+    }
+}
+
+static void via_bulk_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    if (via_bulk.target == id_bulk_dynamic_keymap) {
+        dynamic_keymap_set_buffer(offset, size, data);
+    } else {
+        dynamic_keymap_macro_set_buffer(offset, size, data);
+    }
+}
+
+static void via_bulk_send_status(uint8_t *data, uint8_t length, uint8_t status) {
+    memset(data, 0, length);
+    data[0] = id_bulk_transfer;
+    data[1] = id_bulk_status;
+    data[2] = status;
+    data[3] = via_bulk.crc >> 8;
+    data[4] = via_bulk.crc & 0xFF;
+    raw_hid_send(data, length);
+}
+
+// Handles id_bulk_transfer, setting up the transfer described by the packet
+static void via_bulk_begin(uint8_t *command_data) {
+    uint8_t  direction = command_data[0];
+    uint8_t  target    = command_data[1];
+    uint16_t offset    = (command_data[2] << 8) | command_data[3];
+    uint16_t size      = (command_data[4] << 8) | command_data[5];
+    uint16_t limit     = via_bulk_target_size(target);
+
+    via_bulk.remaining = 0;
+    if ((direction != id_bulk_read && direction != id_bulk_write) || size == 0 || offset >= limit || size > limit - offset) {
+        command_data[0] = id_bulk_invalid;
+        return;
+    }
+
+    via_bulk.direction    = direction;
+    via_bulk.target       = target;
+    via_bulk.offset       = offset;
+    via_bulk.remaining    = size;
+    via_bulk.crc          = 0xFFFF;
+    via_bulk.expected_crc = (command_data[6] << 8) | command_data[7];
+    via_bulk.last_packet  = timer_read();
+}
+
+// Consumes a data packet of a bulk write
+static void via_bulk_receive(uint8_t *data, uint8_t length) {
+    if (via_bulk.direction != id_bulk_write || via_bulk.remaining == 0) {
+        // the rest of a write that was closed already, ignored until the host starts a new transfer
+        return;
+    }
+    if (timer_elapsed(via_bulk.last_packet) >= VIA_BULK_TRANSFER_TIMEOUT) {
+        via_bulk.remaining = 0;
+        via_bulk_send_status(data, length, id_bulk_aborted);
+        return;
+    }
+
+    uint8_t *payload = &(data[VIA_BULK_DATA_HEADER_SIZE]);
+    uint16_t size    = length - VIA_BULK_DATA_HEADER_SIZE;
+    if (via_bulk.remaining < size) {
+        size = via_bulk.remaining;
+    }
+    via_bulk.crc = via_bulk_crc16(via_bulk.crc, payload, size);
+    via_bulk_set_buffer(via_bulk.offset, size, payload);
+    via_bulk.offset += size;
+    via_bulk.remaining -= size;
+    via_bulk.last_packet = timer_read();
+
+    if (via_bulk.remaining == 0) {
+        via_bulk_send_status(data, length, via_bulk.crc == via_bulk.expected_crc ? id_bulk_ok : id_bulk_crc_error);
+    }
+}
+
+// Sends the data of a bulk read, once the response to id_bulk_transfer is out
+static void via_bulk_send(uint8_t *data, uint8_t length) {
+    if (via_bulk.direction != id_bulk_read || via_bulk.remaining == 0) {
+        return;
+    }
+
+    uint8_t *payload = &(data[VIA_BULK_DATA_HEADER_SIZE]);
+    while (via_bulk.remaining) {
+        uint16_t size = length - VIA_BULK_DATA_HEADER_SIZE;
+        if (via_bulk.remaining < size) {
+            size = via_bulk.remaining;
+        }
+        memset(data, 0, length);
+        data[0] = id_bulk_transfer;
+        data[1] = id_bulk_data;
+        via_bulk_get_buffer(via_bulk.offset, size, payload);
+        via_bulk.crc = via_bulk_crc16(via_bulk.crc, payload, size);
+        via_bulk.offset += size;
+        via_bulk.remaining -= size;
+        raw_hid_send(data, length);
+    }
+    via_bulk_send_status(data, length, id_bulk_ok);
+}
+#endif
+
 // Keyboard level code can override this to handle custom messages from VIA.
 // See raw_hid_receive() implementation.
 // DO NOT call raw_hid_send() in the override function.
@@ -196,6 +333,14 @@ __attribute__((weak)) void raw_hid_receive_kb(uint8_t *data, uint8_t length) {
 // raw_hid_send() is called at the end, with the same buffer, which was
 // possibly modified with returned values.
 void raw_hid_receive(uint8_t *data, uint8_t length) {
+#ifdef VIA_BULK_TRANSFER
+    // data packets are never handled as commands, and commands in between them are handled as usual
+    if (data[0] == id_bulk_transfer && data[1] == id_bulk_data) {
+        via_bulk_receive(data, length);
+        return;
+    }
+#endif
+
     uint8_t *command_id   = &(data[0]);
     uint8_t *command_data = &(data[1]);
     switch (*command_id) {
@@ -373,6 +518,12 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_buffer(offset, size, &command_data[3]);
             break;
         }
+#ifdef VIA_BULK_TRANSFER
+        case id_bulk_transfer: {
+            via_bulk_begin(command_data);
+            break;
+        }
+#endif
         default: {
             // The command ID is not known
             // Return the unhandled state
@@ -384,6 +535,10 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
     // Return the same buffer, optionally with values changed
     // (i.e. returning state to the host, or the unhandled state).
     raw_hid_send(data, length);
+
+#ifdef VIA_BULK_TRANSFER
+    via_bulk_send(data, length);
+#endif
 }
 
 #if defined(VIA_QMK_BACKLIGHT_ENABLE)
@@ -78,9 +78,58 @@ enum via_command_id {
     id_dynamic_keymap_get_layer_count       = 0x11,
     id_dynamic_keymap_get_buffer            = 0x12,
     id_dynamic_keymap_set_buffer            = 0x13,
+    id_bulk_transfer                        = 0x14,
     id_unhandled                            = 0xFF,
 };
 
+// Bulk transfers (VIA_BULK_TRANSFER) move a whole keymap or macro buffer
+// without a request/response round trip for every packet.
+//
+// The host starts a transfer with:
+//   id_bulk_transfer, id_bulk_read or id_bulk_write, target,
+//   offset (2 bytes), length (2 bytes), CRC (2 bytes, writes only)
+// all big-endian, and the keyboard answers with the same packet, with
+// the byte after the command ID set to id_bulk_invalid if the transfer
+// was refused. Keyboards without bulk transfers answer id_unhandled.
+//
+// For a write, the host then sends the data as consecutive raw HID packets of
+//   id_bulk_transfer, id_bulk_data, data (the last one padded)
+// which are not answered. For a read, the keyboard sends the data the same way.
+// Other commands can be sent in between, and are answered as usual.
+// Either way, the transfer ends with a status packet from the keyboard:
+//   id_bulk_transfer, id_bulk_status, id_bulk_ok or id_bulk_crc_error,
+//   CRC of the transferred data (2 bytes)
+// The CRC is CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF).
+// Data is written as it arrives, so after a CRC error the target is in an
+// unknown state, and the host should write it again.
+// A write that stalls for VIA_BULK_TRANSFER_TIMEOUT milliseconds is closed:
+// the next data packet is answered with an id_bulk_aborted status, and data
+// packets are ignored from then on, until the host starts a new transfer.
+#ifndef VIA_BULK_TRANSFER_TIMEOUT
+#    define VIA_BULK_TRANSFER_TIMEOUT 500
+#endif
+
+#define VIA_BULK_DATA_HEADER_SIZE 2
+
+enum via_bulk_transfer_id {
+    id_bulk_read    = 0x01,
+    id_bulk_write   = 0x02,
+    id_bulk_status  = 0x03,
+    id_bulk_data    = 0x04,
+    id_bulk_invalid = 0xFF,
+};
+
+enum via_bulk_transfer_target {
+    id_bulk_dynamic_keymap       = 0x01,
+    id_bulk_dynamic_keymap_macro = 0x02,
+};
+
+enum via_bulk_transfer_status {
+    id_bulk_ok        = 0x00,
+    id_bulk_crc_error = 0x01,
+    id_bulk_aborted   = 0x02,
+};
+
 enum via_keyboard_value_id {
     id_uptime              = 0x01,  //
     id_layout_options      = 0x02,
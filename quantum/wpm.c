@@ -17,14 +17,66 @@
 
 #include "wpm.h"
 
-#include <math.h>
+#ifdef SPLIT_KEYBOARD
+#    include "split_util.h"
+#endif
+
+#if WPM_SAMPLE_COUNT < 2 || WPM_SAMPLE_COUNT > UINT8_MAX
+#    error "WPM_SAMPLE_COUNT has to be between 2 and 255"
+#endif
+
+// the timestamps are 16 bit, and have to expire well before they wrap around
+#if WPM_SAMPLE_WINDOW > 60000
+#    error "WPM_SAMPLE_WINDOW can be at most 60000"
+#endif
 
 // WPM Stuff
 static uint8_t  current_wpm = 0;
 static uint16_t wpm_timer   = 0;
 
-// This smoothing is 40 keystrokes
-static const float wpm_smoothing = WPM_SMOOTHING;
+// Ring buffer with the timestamps of the latest keystrokes, oldest first
+static uint16_t wpm_samples[WPM_SAMPLE_COUNT];
+static uint8_t  wpm_sample_head  = 0;
+static uint8_t  wpm_sample_count = 0;
+
+static void push_sample(uint16_t now) {
+    if (wpm_sample_count == WPM_SAMPLE_COUNT) {
+        // full, the oldest keystroke makes room
+        wpm_sample_head = (wpm_sample_head + 1) % WPM_SAMPLE_COUNT;
+        wpm_sample_count--;
+    }
+    wpm_samples[(wpm_sample_head + wpm_sample_count) % WPM_SAMPLE_COUNT] = now;
+    wpm_sample_count++;
+}
+
+static void drop_expired_samples(uint16_t now) {
+    while (wpm_sample_count > 0 && TIMER_DIFF_16(now, wpm_samples[wpm_sample_head]) > WPM_SAMPLE_WINDOW) {
+        wpm_sample_head = (wpm_sample_head + 1) % WPM_SAMPLE_COUNT;
+        wpm_sample_count--;
+    }
+}
+
+/* Keystrokes per minute over the samples still in the window: the intervals between them,
+ * up to now, so the rate falls off smoothly once typing stops. */
+static uint8_t wpm_from_samples(uint16_t now) {
+    drop_expired_samples(now);
+    if (wpm_sample_count < 2) {
+        return 0;
+    }
+
+    uint32_t span = TIMER_DIFF_16(now, wpm_samples[wpm_sample_head]);
+    if (span == 0) {
+        span = 1;
+    }
+    uint32_t wpm = (uint32_t)(wpm_sample_count - 1) * 60000 / WPM_ESTIMATED_WORD_SIZE / span;
+    return wpm > UINT8_MAX ? UINT8_MAX : wpm;
+}
+
+static void recompute_wpm(void) {
+    uint16_t now = timer_read();
+    current_wpm  = wpm_from_samples(now);
+    wpm_timer    = now;
+}
 
 void set_current_wpm(uint8_t new_wpm) { current_wpm = new_wpm; }
 
@@ -70,31 +122,27 @@ __attribute__((weak)) uint8_t wpm_regress_count(uint16_t keycode) {
 
 void update_wpm(uint16_t keycode) {
     if (wpm_keycode(keycode)) {
-        if (wpm_timer > 0) {
-            uint16_t latest_wpm = 60000 / timer_elapsed(wpm_timer) / WPM_ESTIMATED_WORD_SIZE;
-            if (latest_wpm > UINT8_MAX) {
-                latest_wpm = UINT8_MAX;
-            }
-            current_wpm += ceilf((latest_wpm - current_wpm) * wpm_smoothing);
-        }
-        wpm_timer = timer_read();
+        push_sample(timer_read());
+        recompute_wpm();
     }
 #ifdef WPM_ALLOW_COUNT_REGRESSION
     uint8_t regress = wpm_regress_count(keycode);
     if (regress) {
-        if (current_wpm < regress) {
-            current_wpm = 0;
-        } else {
-            current_wpm -= regress;
-        }
-        wpm_timer = timer_read();
+        // take back the latest keystrokes
+        wpm_sample_count = regress < wpm_sample_count ? wpm_sample_count - regress : 0;
+        recompute_wpm();
     }
 #endif
 }
 
 void decay_wpm(void) {
-    if (timer_elapsed(wpm_timer) > 1000) {
-        current_wpm += (-current_wpm) * wpm_smoothing;
-        wpm_timer = timer_read();
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_WPM_ENABLE)
+    // the slave shows what the master computed
+    if (!is_keyboard_master()) {
+        return;
+    }
+#endif
+    if (timer_elapsed(wpm_timer) >= WPM_UPDATE_INTERVAL) {
+        recompute_wpm();
     }
 }
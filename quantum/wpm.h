@@ -22,8 +22,14 @@
 #ifndef WPM_ESTIMATED_WORD_SIZE
 #    define WPM_ESTIMATED_WORD_SIZE 5
 #endif
-#ifndef WPM_SMOOTHING
-#    define WPM_SMOOTHING 0.0487
+#ifndef WPM_SAMPLE_WINDOW
+#    define WPM_SAMPLE_WINDOW 5000
+#endif
+#ifndef WPM_SAMPLE_COUNT
+#    define WPM_SAMPLE_COUNT 32
+#endif
+#ifndef WPM_UPDATE_INTERVAL
+#    define WPM_UPDATE_INTERVAL 250
 #endif
 
 bool wpm_keycode(uint16_t keycode);
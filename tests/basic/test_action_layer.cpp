@@ -17,6 +17,7 @@
 #include "test_common.hpp"
 
 using testing::_;
+using testing::AnyNumber;
 using testing::Return;
 
 class ActionLayer : public TestFixture {};
@@ -90,3 +91,56 @@ TEST_F(ActionLayer, LayerStateCmp) {
 //     layer_off(2);
 //     EXPECT_EQ(layer_state, 0b1000);
 // }
+
+TEST_F(ActionLayer, LayerLookupFollowsLayerChanges) {
+    TestDriver driver;
+    keypos_t   key_a = {.col = 0, .row = 0};
+    keypos_t   key_b = {.col = 1, .row = 0};
+
+    // Layer changes clear the keyboard report
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    layer_clear();
+    EXPECT_EQ(layer_switch_get_layer(key_a), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b), 0);
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a), 1);
+    // Transparent on layer 1
+    EXPECT_EQ(layer_switch_get_layer(key_b), 0);
+
+    // Writes that bypass layer_state_set are picked up as well
+    layer_state = 0;
+    EXPECT_EQ(layer_switch_get_layer(key_a), 0);
+    layer_state = (layer_state_t)1 << 1;
+    EXPECT_EQ(layer_switch_get_layer(key_a), 1);
+
+    layer_clear();
+    EXPECT_EQ(layer_switch_get_layer(key_a), 0);
+}
+
+TEST_F(ActionLayer, KeyOnHigherLayerIsReported) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    layer_on(1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    press_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_X)));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    release_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    layer_off(1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    press_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
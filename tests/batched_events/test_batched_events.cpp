@@ -0,0 +1,107 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+// The multi key cases of tests/basic, with every changed key processed in the same scan
+class BatchedEvents : public TestFixture {};
+
+TEST_F(BatchedEvents, CorrectKeysAreReportedWhenTwoKeysArePressed) {
+    TestDriver driver;
+    InSequence s;
+    press_key(1, 0);
+    press_key(0, 3);
+    // Both keys are processed in the same scan, in matrix order
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B, KC_C)));
+    keyboard_task();
+    release_key(1, 0);
+    release_key(0, 3);
+    // Note that the first key released is the first one in the matrix order
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_C)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    keyboard_task();
+}
+
+TEST_F(BatchedEvents, LeftShiftIsReportedCorrectly) {
+    TestDriver driver;
+    InSequence s;
+    press_key(3, 0);
+    press_key(0, 0);
+    // Modifiers are processed in matrix order as well
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A, KC_LSFT)));
+    keyboard_task();
+    release_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    keyboard_task();
+    release_key(3, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    keyboard_task();
+}
+
+TEST_F(BatchedEvents, PressLeftShiftAndControl) {
+    TestDriver driver;
+    InSequence s;
+    press_key(3, 0);
+    press_key(5, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT, KC_LCTRL)));
+    keyboard_task();
+}
+
+TEST_F(BatchedEvents, LeftAndRightShiftCanBePressedAtTheSameTime) {
+    TestDriver driver;
+    InSequence s;
+    press_key(3, 0);
+    press_key(4, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT, KC_RSFT)));
+    keyboard_task();
+}
+
+TEST_F(BatchedEvents, ChordIsReportedWithinOneScan) {
+    TestDriver driver;
+    InSequence s;
+
+    // A four key roll landing in a single scan
+    press_key(0, 0);  // KC_A
+    press_key(1, 0);  // KC_B
+    press_key(0, 3);  // KC_C
+    press_key(1, 3);  // KC_D
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A, KC_B)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A, KC_B, KC_C)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A, KC_B, KC_C, KC_D)));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Nothing is left over for the following scans
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    idle_for(3);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    clear_all_keys();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B, KC_C, KC_D)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_C, KC_D)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_D)));
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
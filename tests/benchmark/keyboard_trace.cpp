@@ -0,0 +1,109 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keyboard_trace.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+extern "C" {
+#include "quantum.h"
+}
+
+bool load_trace(const std::string& path, KeyTrace& trace) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        std::istringstream fields(line);
+        unsigned           tick, row, col, pressed;
+        if (!(fields >> tick >> row >> col >> pressed) || row >= MATRIX_ROWS || col >= MATRIX_COLS) return false;
+        trace.push_back({tick, (uint8_t)row, (uint8_t)col, pressed != 0});
+    }
+
+    std::stable_sort(trace.begin(), trace.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.tick < b.tick; });
+    return true;
+}
+
+KeyTrace synthetic_trace(unsigned keystrokes, unsigned seed) {
+    // positions in the benchmark keymap, see keymap.c
+    static const uint8_t chords[][3][2] = {
+        {{1, 6}, {1, 7}, {0xFF, 0}}, // J K
+        {{1, 2}, {1, 3}, {0xFF, 0}}, // D F
+        {{1, 1}, {1, 2}, {1, 3}},    // S D F
+        {{0, 1}, {0, 2}, {0xFF, 0}}, // W E
+    };
+    static const uint8_t mods[][2]      = {{3, 0}, {3, 1}, {3, 3}, {3, 9}}; // LSFT LCTL MO(1) RSFT
+    static const uint8_t tap_dances[][2] = {{1, 9}, {3, 7}};
+
+    std::mt19937                       rng(seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> gap(10, 120);
+    std::uniform_int_distribution<int> hold(20, 150);
+    std::uniform_int_distribution<int> row(0, 2);
+    std::uniform_int_distribution<int> col(0, MATRIX_COLS - 1);
+
+    KeyTrace trace;
+    uint32_t released_at[MATRIX_ROWS][MATRIX_COLS] = {};
+    uint32_t tick                                  = 0;
+
+    auto keystroke = [&](uint8_t r, uint8_t c, uint32_t down, uint32_t up) {
+        // a key can't go down again before it came up
+        if (released_at[r][c] >= down) return;
+        trace.push_back({down, r, c, true});
+        trace.push_back({up, r, c, false});
+        released_at[r][c] = up;
+    };
+
+    for (unsigned i = 0; i < keystrokes; i++) {
+        tick += gap(rng);
+        int kind = percent(rng);
+
+        if (kind < 10) {
+            const auto& chord = chords[percent(rng) % 4];
+            uint32_t    up    = tick + hold(rng);
+            for (int k = 0; k < 3 && chord[k][0] != 0xFF; k++) {
+                keystroke(chord[k][0], chord[k][1], tick + k * 3, up + k * 5);
+            }
+        } else if (kind < 15) {
+            const auto& mod = mods[percent(rng) % 4];
+            uint32_t    up  = tick + 300;
+            keystroke(mod[0], mod[1], tick, up);
+            for (uint32_t t = tick + 20; t < up - 60; t += gap(rng)) {
+                keystroke(row(rng), col(rng), t, t + 40);
+            }
+            tick = up;
+        } else if (kind < 20) {
+            const auto& td = tap_dances[percent(rng) % 2];
+            keystroke(td[0], td[1], tick, tick + 30);
+            if (percent(rng) < 50) {
+                keystroke(td[0], td[1], tick + 60, tick + 90);
+                tick += 60;
+            }
+        } else {
+            keystroke(row(rng), col(rng), tick, tick + hold(rng));
+        }
+    }
+
+    std::stable_sort(trace.begin(), trace.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.tick < b.tick; });
+    return trace;
+}
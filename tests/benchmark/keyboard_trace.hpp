@@ -0,0 +1,39 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* One matrix transition, applied before the scan loop of the given tick */
+struct TraceEvent {
+    uint32_t tick;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+};
+
+using KeyTrace = std::vector<TraceEvent>;
+
+/* Reads a recorded trace, one "tick row col pressed" event per line, '#' starts a comment.
+ * Returns false if the file can't be read or holds a malformed line. */
+bool load_trace(const std::string& path, KeyTrace& trace);
+
+/* Generates reproducible typing: rolling keypresses, chords on the combo keys and held modifiers.
+ * Every key pressed in the trace is released again before it ends. */
+KeyTrace synthetic_trace(unsigned keystrokes, unsigned seed);
@@ -0,0 +1,65 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "quantum.h"
+
+enum { TD_SCLN, TD_ESC };
+
+// clang-format off
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] =
+        {
+            // 0        1        2        3       4        5        6       7        8        9
+            {KC_Q,    KC_W,    KC_E,    KC_R,   KC_T,    KC_Y,    KC_U,   KC_I,    KC_O,    KC_P},
+            {KC_A,    KC_S,    KC_D,    KC_F,   KC_G,    KC_H,    KC_J,   KC_K,    KC_L,    TD(TD_SCLN)},
+            {KC_Z,    KC_X,    KC_C,    KC_V,   KC_B,    KC_N,    KC_M,   KC_COMM, KC_DOT,  KC_SLSH},
+            {KC_LSFT, KC_LCTL, KC_LALT, MO(1),  KC_SPC,  KC_BSPC, KC_ENT, TD(TD_ESC), KC_RALT, KC_RSFT},
+        },
+    [1] =
+        {
+            {KC_1,    KC_2,    KC_3,    KC_4,    KC_5,    KC_6,    KC_7,    KC_8,    KC_9,    KC_0},
+            {KC_LEFT, KC_DOWN, KC_UP,   KC_RGHT, KC_HOME, KC_END,  KC_PGUP, KC_PGDN, KC_MINS, KC_EQL},
+            {_______, _______, _______, _______, _______, _______, _______, _______, _______, _______},
+            {_______, _______, _______, _______, _______, _______, _______, _______, _______, _______},
+        },
+};
+// clang-format on
+
+const uint16_t PROGMEM jk_combo[]  = {KC_J, KC_K, COMBO_END};
+const uint16_t PROGMEM df_combo[]  = {KC_D, KC_F, COMBO_END};
+const uint16_t PROGMEM sdf_combo[] = {KC_S, KC_D, KC_F, COMBO_END};
+const uint16_t PROGMEM we_combo[]  = {KC_W, KC_E, COMBO_END};
+
+combo_t key_combos[COMBO_COUNT] = {
+    COMBO(jk_combo, KC_ESC),
+    COMBO(df_combo, KC_TAB),
+    COMBO(sdf_combo, KC_ENT),
+    COMBO(we_combo, KC_BSPC),
+};
+
+qk_tap_dance_action_t tap_dance_actions[] = {
+    [TD_SCLN] = ACTION_TAP_DANCE_DOUBLE(KC_SCLN, KC_QUOT),
+    [TD_ESC]  = ACTION_TAP_DANCE_DOUBLE(KC_ESC, KC_GRV),
+};
+
+const key_override_t shift_bspc_override = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+const key_override_t shift_comm_override = ko_make_basic(MOD_MASK_SHIFT, KC_COMM, KC_SCLN);
+
+const key_override_t **key_overrides = (const key_override_t *[]){
+    &shift_bspc_override,
+    &shift_comm_override,
+    NULL,
+};
@@ -0,0 +1,187 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "keyboard_trace.hpp"
+#include "test_matrix.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+extern "C" {
+#include "quantum.h"
+#include "keyboard.h"
+#include "host.h"
+#include "debug.h"
+#include "eeconfig.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+/* Replays key traces through keyboard_task -> action_exec -> host_keyboard_send and measures
+ * the wall clock cost of the pipeline and the number of scans each input takes to be reported.
+ *
+ * QMK_BENCHMARK_TRACE=<file> replays a recorded trace instead of the synthetic one,
+ * QMK_BENCHMARK_KEYSTROKES=<n> changes the length of the synthetic one. */
+class Benchmark : public testing::Test {
+public:
+    static void SetUpTestCase() {
+        host_set_driver(&driver);
+        eeconfig_init_quantum();
+        eeconfig_update_debug(debug_config.raw);
+        keyboard_init();
+    }
+
+protected:
+    struct Result {
+        unsigned events      = 0;
+        unsigned scans       = 0;
+        unsigned reports     = 0;
+        unsigned reported    = 0; // events that got a report before the next input
+        uint64_t latency_sum = 0;
+        uint32_t latency_max = 0;
+        double   idle_ns     = 0; // wall time of the same number of scans without input
+        double   run_ns      = 0;
+    };
+
+    Result replay(const KeyTrace& trace) {
+        Result   result;
+        uint32_t first = trace.front().tick;
+        // leave time for tap dances and combos to resolve after the last event
+        uint32_t last = trace.back().tick + TAPPING_TERM + COMBO_TERM + 10;
+
+        result.scans   = last - first + 1;
+        result.idle_ns = time_scans([&](uint32_t) {}, result.scans);
+
+        recorder       = {};
+        size_t next    = 0;
+        result.run_ns  = time_scans(
+            [&](uint32_t scan) {
+                recorder.tick = scan;
+                while (next < trace.size() && trace[next].tick - first == scan) {
+                    const TraceEvent& event = trace[next++];
+                    if (event.pressed) {
+                        press_key(event.col, event.row);
+                    } else {
+                        release_key(event.col, event.row);
+                    }
+                    // inputs still waiting for a report got absorbed by a combo, tap dance or layer
+                    if (recorder.pending_tick != scan) recorder.pending = 0;
+                    recorder.pending_tick = scan;
+                    recorder.pending++;
+                }
+            },
+            result.scans);
+
+        result.events      = trace.size();
+        result.reports     = recorder.reports;
+        result.reported    = recorder.reported;
+        result.latency_sum = recorder.latency_sum;
+        result.latency_max = recorder.latency_max;
+        return result;
+    }
+
+    void report_result(const char* name, const Result& result) {
+        double busy_ns = std::max(result.run_ns - result.idle_ns, 0.0);
+
+        std::cout << "[ BENCHMARK] " << name << ": " << result.events << " events, " << result.scans << " scans, " << result.reports << " reports" << std::endl;
+        std::cout << "[ BENCHMARK]   " << result.events / (result.run_ns / 1e9) << " events/s, " << result.run_ns / result.scans << " ns/scan, " << result.idle_ns / result.scans << " ns/idle scan, " << busy_ns / result.events << " ns/event above idle" << std::endl;
+        if (result.reported) {
+            std::cout << "[ BENCHMARK]   report latency: avg " << (double)result.latency_sum / result.reported << " scans, max " << result.latency_max << " scans, " << result.events - result.reported << " events absorbed" << std::endl;
+        }
+    }
+
+    struct Recorder {
+        uint32_t tick;
+        uint32_t pending_tick;
+        unsigned pending;
+        unsigned reports;
+        unsigned reported;
+        uint64_t latency_sum;
+        uint32_t latency_max;
+
+        report_keyboard_t last_report;
+    };
+
+    static Recorder recorder;
+
+private:
+    template <typename F>
+    static double time_scans(F&& before_scan, uint32_t scans) {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t scan = 0; scan < scans; scan++) {
+            before_scan(scan);
+            keyboard_task();
+            advance_time(1);
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    static uint8_t keyboard_leds(void) { return 0; }
+    static void    send_keyboard(report_keyboard_t* report) {
+        recorder.reports++;
+        recorder.last_report = *report;
+        if (recorder.pending) {
+            uint32_t latency = recorder.tick - recorder.pending_tick;
+            recorder.reported += recorder.pending;
+            recorder.latency_sum += (uint64_t)latency * recorder.pending;
+            recorder.latency_max = std::max(recorder.latency_max, latency);
+            recorder.pending     = 0;
+        }
+    }
+    static void send_mouse(report_mouse_t* report) {}
+    static void send_system(uint16_t data) {}
+    static void send_consumer(uint16_t data) {}
+
+    static host_driver_t driver;
+};
+
+Benchmark::Recorder Benchmark::recorder;
+host_driver_t       Benchmark::driver = {&Benchmark::keyboard_leds, &Benchmark::send_keyboard, &Benchmark::send_mouse, &Benchmark::send_system, &Benchmark::send_consumer};
+
+TEST_F(Benchmark, SyntheticTrace) {
+    const char* keystrokes = std::getenv("QMK_BENCHMARK_KEYSTROKES");
+    KeyTrace    trace      = synthetic_trace(keystrokes ? std::atoi(keystrokes) : 5000, 1);
+    ASSERT_FALSE(trace.empty());
+
+    Result result = replay(trace);
+    report_result("synthetic", result);
+
+    EXPECT_GT(result.reported, 0u);
+    EXPECT_LE(result.latency_max, (uint32_t)(TAPPING_TERM + COMBO_TERM));
+    // every key was released, so the keyboard must have ended up reporting nothing
+    report_keyboard_t empty = {};
+    EXPECT_EQ(recorder.last_report, empty);
+}
+
+TEST_F(Benchmark, RecordedTrace) {
+    const char* path = std::getenv("QMK_BENCHMARK_TRACE");
+    if (!path) {
+        std::cout << "[ BENCHMARK] QMK_BENCHMARK_TRACE not set, skipping recorded trace" << std::endl;
+        return;
+    }
+
+    KeyTrace trace;
+    ASSERT_TRUE(load_trace(path, trace)) << "can't read trace " << path;
+    ASSERT_FALSE(trace.empty());
+
+    report_result(path, replay(trace));
+}
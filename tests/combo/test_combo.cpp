@@ -0,0 +1,102 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+using testing::_;
+
+class Combo : public TestFixture {};
+
+TEST_F(Combo, KeyOutsideAnyComboIsReportedImmediately) {
+    TestDriver driver;
+    press_key(4, 0);  // KC_E
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    release_key(4, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, TwoKeyComboFires) {
+    TestDriver driver;
+    press_key(2, 0);  // KC_C
+    press_key(3, 0);  // KC_D
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    idle_for(2);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_Y)));
+    idle_for(COMBO_TERM + 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    release_key(2, 0);
+    release_key(3, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    idle_for(2);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, LongerOverlappingComboWins) {
+    TestDriver driver;
+    press_key(0, 0);  // KC_A
+    press_key(1, 0);  // KC_B
+    press_key(2, 0);  // KC_C
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    idle_for(3);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_Z)));
+    idle_for(COMBO_TERM + 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    clear_all_keys();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    idle_for(3);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, PartialComboFallsBackToKey) {
+    TestDriver driver;
+    press_key(0, 0);  // KC_A
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    idle_for(COMBO_TERM + 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    release_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // The combo state was cleared, so the combo still works afterwards
+    press_key(0, 0);
+    press_key(1, 0);
+    idle_for(2);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_X)));
+    idle_for(COMBO_TERM + 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    clear_all_keys();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    idle_for(3);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,133 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeprom.h"
+#include "dynamic_keymap.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+#define KEYMAP_EEPROM(offset) ((uint8_t *)DYNAMIC_KEYMAP_EEPROM_ADDR + (offset))
+
+class DynamicKeymapRamMirror : public TestFixture {
+   protected:
+    void SetUp() override { dynamic_keymap_reset(); }
+};
+
+TEST_F(DynamicKeymapRamMirror, ResetCopiesFlashKeymap) {
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_A);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 9), KC_0);
+    EXPECT_EQ(eeprom_read_byte(KEYMAP_EEPROM(0)), KC_A >> 8);
+    EXPECT_EQ(eeprom_read_byte(KEYMAP_EEPROM(1)), KC_A & 0xFF);
+}
+
+TEST_F(DynamicKeymapRamMirror, SetKeycodeWritesThrough) {
+    dynamic_keymap_set_keycode(1, 2, 3, LCTL(KC_Z));
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), LCTL(KC_Z));
+
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(1, 2, 3);
+    EXPECT_EQ(eeprom_read_byte(address), LCTL(KC_Z) >> 8);
+    EXPECT_EQ(eeprom_read_byte(address + 1), LCTL(KC_Z) & 0xFF);
+}
+
+TEST_F(DynamicKeymapRamMirror, LookupsDoNotReadEeprom) {
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(0, 0, 1);
+    eeprom_write_byte(address + 1, KC_Z);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), KC_B);
+}
+
+TEST_F(DynamicKeymapRamMirror, BufferRoundTrip) {
+    uint8_t data[28];
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        data[i] = i + 1;
+    }
+    dynamic_keymap_set_buffer(10, sizeof(data), data);
+
+    uint8_t read[sizeof(data)] = {0};
+    dynamic_keymap_get_buffer(10, sizeof(read), read);
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        EXPECT_EQ(read[i], data[i]);
+        EXPECT_EQ(eeprom_read_byte(KEYMAP_EEPROM(10 + i)), data[i]);
+    }
+}
+
+TEST_F(DynamicKeymapRamMirror, BufferIsClampedToKeymapSize) {
+    const uint16_t size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+    uint8_t        data[4] = {0x12, 0x34, 0x56, 0x78};
+    dynamic_keymap_set_buffer(size - 2, sizeof(data), data);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, MATRIX_ROWS - 1, MATRIX_COLS - 1), 0x1234);
+    EXPECT_EQ(eeprom_read_byte(KEYMAP_EEPROM(size)), 0);
+
+    uint8_t read[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    dynamic_keymap_get_buffer(size - 2, sizeof(read), read);
+    EXPECT_EQ(read[0], 0x12);
+    EXPECT_EQ(read[1], 0x34);
+    EXPECT_EQ(read[2], 0);
+    EXPECT_EQ(read[3], 0);
+}
+
+TEST_F(DynamicKeymapRamMirror, OutOfRangeKeysAreIgnored) {
+    const uint16_t size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+    dynamic_keymap_set_keycode(DYNAMIC_KEYMAP_LAYER_COUNT, 0, 0, KC_Z);
+    dynamic_keymap_set_keycode(0, MATRIX_ROWS, 0, KC_Z);
+    dynamic_keymap_set_keycode(0, 0, MATRIX_COLS, KC_Z);
+    dynamic_keymap_set_keycode(255, 255, 255, KC_Z);
+    EXPECT_EQ(eeprom_read_byte(KEYMAP_EEPROM(size)), 0);
+    EXPECT_EQ(eeprom_read_byte(KEYMAP_EEPROM(size + 1)), 0);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_1);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 0), KC_NO);
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(DYNAMIC_KEYMAP_LAYER_COUNT, 0, 0), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, MATRIX_ROWS, 0), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, MATRIX_COLS), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(255, 255, 255), KC_NO);
+}
+
+TEST_F(DynamicKeymapRamMirror, KeyPressUsesDynamicKeymap) {
+    TestDriver driver;
+    dynamic_keymap_set_keycode(0, 0, 0, KC_Q);
+    press_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_Q)));
+    keyboard_task();
+    release_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    keyboard_task();
+}
+
+TEST_F(DynamicKeymapRamMirror, KeymapWritesInvalidateLayerLookupCache) {
+    TestDriver driver;
+    keypos_t   key = {.col = 1, .row = 0};
+
+    // Layer changes clear the keyboard report
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+
+    dynamic_keymap_set_keycode(1, 0, 1, KC_TRNS);
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+
+    const uint16_t offset  = ((1 * MATRIX_ROWS + 0) * MATRIX_COLS + 1) * 2;
+    uint8_t        data[2] = {KC_W >> 8, KC_W & 0xFF};
+    dynamic_keymap_set_buffer(offset, sizeof(data), data);
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+
+    layer_clear();
+}
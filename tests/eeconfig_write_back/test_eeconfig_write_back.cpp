@@ -0,0 +1,102 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeprom.h"
+#include "eeconfig.h"
+void advance_time(uint32_t ms);
+}
+
+class EeconfigWriteBack : public TestFixture {
+   protected:
+    void SetUp() override {
+        eeconfig_init();
+        eeconfig_flush();
+    }
+};
+
+TEST_F(EeconfigWriteBack, UpdateIsDeferredButReadBack) {
+    eeconfig_update_user(0x12345678);
+    EXPECT_TRUE(eeconfig_is_dirty());
+    EXPECT_EQ(eeconfig_read_user(), 0x12345678u);
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_USER), 0u);
+}
+
+TEST_F(EeconfigWriteBack, CommitsAfterQuietPeriod) {
+    eeconfig_update_user(0x12345678);
+    advance_time(EECONFIG_WRITE_BACK_DELAY - 1);
+    eeconfig_task();
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_USER), 0u);
+
+    advance_time(1);
+    eeconfig_task();
+    EXPECT_FALSE(eeconfig_is_dirty());
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_USER), 0x12345678u);
+}
+
+TEST_F(EeconfigWriteBack, RepeatedUpdatesRestartQuietPeriodAndCoalesce) {
+    for (uint32_t i = 1; i <= 10; i++) {
+        eeconfig_update_kb(i);
+        advance_time(EECONFIG_WRITE_BACK_DELAY / 2);
+        eeconfig_task();
+        EXPECT_EQ(eeprom_read_dword(EECONFIG_KEYBOARD), 0u);
+    }
+
+    advance_time(EECONFIG_WRITE_BACK_DELAY / 2);
+    eeconfig_task();
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_KEYBOARD), 10u);
+}
+
+TEST_F(EeconfigWriteBack, FlushCommitsImmediately) {
+    eeconfig_update_debug(0x5A);
+    eeconfig_update_handedness(true);
+    eeconfig_flush();
+    EXPECT_FALSE(eeconfig_is_dirty());
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_DEBUG), 0x5A);
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_HANDEDNESS), 1);
+}
+
+TEST_F(EeconfigWriteBack, ReadMergesPendingAndCommittedBytes) {
+    eeconfig_update_keymap(0xA55A);
+    eeconfig_flush();
+
+    uint8_t byte = 0x3C;
+    eeconfig_update_block(&byte, EECONFIG_KEYMAP_UPPER_BYTE, sizeof(byte));
+    EXPECT_EQ(eeconfig_read_keymap(), 0x3C5A);
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_KEYMAP_UPPER_BYTE), 0xA5);
+}
+
+TEST_F(EeconfigWriteBack, BlockPastEeconfigIsWrittenThrough) {
+    uint8_t data[4] = {1, 2, 3, 4};
+    uint8_t read[4];
+    eeconfig_update_block(data, (void *)(EECONFIG_SIZE - 2), sizeof(data));
+
+    EXPECT_EQ(eeprom_read_byte((uint8_t *)(EECONFIG_SIZE - 2)), 0);
+    EXPECT_EQ(eeprom_read_byte((uint8_t *)EECONFIG_SIZE), 3);
+    EXPECT_EQ(eeprom_read_byte((uint8_t *)(EECONFIG_SIZE + 1)), 4);
+    eeconfig_read_block(read, (void *)(EECONFIG_SIZE - 2), sizeof(read));
+    EXPECT_EQ(memcmp(read, data, sizeof(data)), 0);
+}
+
+TEST_F(EeconfigWriteBack, InitDiscardsPendingUpdates) {
+    eeconfig_update_user(0x12345678);
+    eeconfig_init();
+    EXPECT_EQ(eeconfig_read_user(), 0u);
+    eeconfig_flush();
+    EXPECT_EQ(eeprom_read_dword(EECONFIG_USER), 0u);
+}
@@ -0,0 +1,111 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+extern "C" {
+// pointing_device.h names a parameter 'new', which C++ does not accept
+void           pointing_device_send(void);
+report_mouse_t pointing_device_get_report(void);
+void           pointing_device_set_report(report_mouse_t newMouseReport);
+void           pointing_device_add_motion(int16_t x, int16_t y);
+void           advance_time(uint32_t ms);
+}
+
+using testing::_;
+
+MATCHER_P2(MouseMotion, x, y, "") { return arg.x == x && arg.y == y; }
+
+class PointingDeviceAccumulate : public TestFixture {
+   protected:
+    void SetUp() override {
+        // let the previous report interval run out
+        advance_time(POINTING_DEVICE_REPORT_INTERVAL);
+    }
+};
+
+TEST_F(PointingDeviceAccumulate, KeepsCountsBelowDivisor) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(0);
+    pointing_device_add_motion(POINTING_DEVICE_MOTION_DIVISOR - 1, 0);
+    pointing_device_send();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_mouse_mock(MouseMotion(1, 0)));
+    pointing_device_add_motion(1, 0);
+    pointing_device_send();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(PointingDeviceAccumulate, HoldsMotionUntilReportInterval) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_mouse_mock(MouseMotion(2, -1)));
+    pointing_device_add_motion(2 * POINTING_DEVICE_MOTION_DIVISOR, -POINTING_DEVICE_MOTION_DIVISOR);
+    pointing_device_send();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(0);
+    for (uint8_t i = 0; i < POINTING_DEVICE_REPORT_INTERVAL; i++) {
+        pointing_device_add_motion(POINTING_DEVICE_MOTION_DIVISOR, 0);
+        pointing_device_send();
+        advance_time(1);
+    }
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_mouse_mock(MouseMotion(POINTING_DEVICE_REPORT_INTERVAL + 1, 0)));
+    pointing_device_add_motion(POINTING_DEVICE_MOTION_DIVISOR, 0);
+    pointing_device_send();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(PointingDeviceAccumulate, SplitsLargeMotionOverReports) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_mouse_mock(MouseMotion(127, -127)));
+    pointing_device_add_motion(200 * POINTING_DEVICE_MOTION_DIVISOR, -150 * POINTING_DEVICE_MOTION_DIVISOR);
+    pointing_device_send();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_mouse_mock(MouseMotion(73, -23)));
+    advance_time(POINTING_DEVICE_REPORT_INTERVAL);
+    pointing_device_send();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(PointingDeviceAccumulate, ButtonChangeIsNotDelayed) {
+    TestDriver driver;
+
+    EXPECT_CALL(driver, send_mouse_mock(MouseMotion(1, 0)));
+    pointing_device_add_motion(POINTING_DEVICE_MOTION_DIVISOR, 0);
+    pointing_device_send();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_mouse_mock(MouseMotion(1, 0)));
+    report_mouse_t report = pointing_device_get_report();
+    report.buttons |= MOUSE_BTN1;
+    pointing_device_set_report(report);
+    pointing_device_add_motion(POINTING_DEVICE_MOTION_DIVISOR, 0);
+    pointing_device_send();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_mouse_mock(_));
+    report.buttons &= ~MOUSE_BTN1;
+    pointing_device_set_report(report);
+    pointing_device_send();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,180 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <array>
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "via.h"
+#include "raw_hid.h"
+#include "dynamic_keymap.h"
+void advance_time(uint32_t ms);
+}
+
+#define RAW_EPSIZE 32
+#define PAYLOAD_SIZE (RAW_EPSIZE - VIA_BULK_DATA_HEADER_SIZE)
+
+typedef std::array<uint8_t, RAW_EPSIZE> packet_t;
+
+static std::vector<packet_t> sent;
+
+extern "C" void raw_hid_send(uint8_t *data, uint8_t length) {
+    packet_t packet;
+    std::copy(data, data + length, packet.begin());
+    sent.push_back(packet);
+}
+
+static uint16_t crc16(const uint8_t *data, size_t size) {
+    uint16_t crc = 0xFFFF;
+    while (size--) {
+        crc ^= (uint16_t)*data++ << 8;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+class ViaBulkTransfer : public TestFixture {
+   protected:
+    void SetUp() override {
+        dynamic_keymap_reset();
+        sent.clear();
+    }
+
+    void receive(packet_t packet) { raw_hid_receive(packet.data(), packet.size()); }
+
+    void begin(uint8_t direction, uint8_t target, uint16_t offset, uint16_t size, uint16_t crc = 0) {
+        receive({id_bulk_transfer, direction, target, (uint8_t)(offset >> 8), (uint8_t)offset, (uint8_t)(size >> 8), (uint8_t)size, (uint8_t)(crc >> 8), (uint8_t)crc});
+    }
+
+    void write(const std::vector<uint8_t> &data) {
+        for (size_t i = 0; i < data.size(); i += PAYLOAD_SIZE) {
+            packet_t packet = {id_bulk_transfer, id_bulk_data};
+            std::copy(data.begin() + i, data.begin() + std::min(data.size(), i + (size_t)PAYLOAD_SIZE), packet.begin() + VIA_BULK_DATA_HEADER_SIZE);
+            receive(packet);
+        }
+    }
+
+    void expectStatus(const packet_t &packet, uint8_t status, uint16_t crc) {
+        EXPECT_EQ(packet[0], id_bulk_transfer);
+        EXPECT_EQ(packet[1], id_bulk_status);
+        EXPECT_EQ(packet[2], status);
+        EXPECT_EQ(packet[3], crc >> 8);
+        EXPECT_EQ(packet[4], crc & 0xFF);
+    }
+};
+
+TEST_F(ViaBulkTransfer, WriteIsAnsweredOnceAtTheEnd) {
+    std::vector<uint8_t> data(80);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = i * 3;
+    }
+    uint16_t crc = crc16(data.data(), data.size());
+
+    begin(id_bulk_write, id_bulk_dynamic_keymap, 4, data.size(), crc);
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(sent[0][0], id_bulk_transfer);
+    EXPECT_EQ(sent[0][1], id_bulk_write);
+
+    write(data);
+    ASSERT_EQ(sent.size(), 2u);
+    expectStatus(sent[1], id_bulk_ok, crc);
+
+    uint8_t stored[80];
+    dynamic_keymap_get_buffer(4, sizeof(stored), stored);
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), stored));
+}
+
+TEST_F(ViaBulkTransfer, WriteReportsCrcError) {
+    std::vector<uint8_t> data(40, 0x42);
+    uint16_t             crc = crc16(data.data(), data.size());
+
+    begin(id_bulk_write, id_bulk_dynamic_keymap_macro, 0, data.size(), crc ^ 1);
+    write(data);
+    ASSERT_EQ(sent.size(), 2u);
+    expectStatus(sent[1], id_bulk_crc_error, crc);
+}
+
+TEST_F(ViaBulkTransfer, ReadStreamsDataAndCrc) {
+    const uint16_t size = 2 * MATRIX_ROWS * MATRIX_COLS * 2;
+    uint8_t        expected[size];
+    dynamic_keymap_get_buffer(0, size, expected);
+
+    begin(id_bulk_read, id_bulk_dynamic_keymap, 0, size);
+    const size_t packets = (size + PAYLOAD_SIZE - 1) / PAYLOAD_SIZE;
+    ASSERT_EQ(sent.size(), 1 + packets + 1);
+    EXPECT_EQ(sent[0][1], id_bulk_read);
+    for (size_t i = 0; i < packets; i++) {
+        EXPECT_EQ(sent[1 + i][0], id_bulk_transfer);
+        EXPECT_EQ(sent[1 + i][1], id_bulk_data);
+    }
+    for (size_t i = 0; i < size; i++) {
+        EXPECT_EQ(sent[1 + i / PAYLOAD_SIZE][VIA_BULK_DATA_HEADER_SIZE + i % PAYLOAD_SIZE], expected[i]);
+    }
+    expectStatus(sent.back(), id_bulk_ok, crc16(expected, size));
+}
+
+TEST_F(ViaBulkTransfer, OutOfRangeTransferIsRefused) {
+    const uint16_t size = 2 * MATRIX_ROWS * MATRIX_COLS * 2;
+    begin(id_bulk_write, id_bulk_dynamic_keymap, size - 2, 4);
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(sent[0][1], id_bulk_invalid);
+
+    receive({id_get_protocol_version});
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_EQ(sent[1][0], id_get_protocol_version);
+    EXPECT_EQ(sent[1][2], VIA_PROTOCOL_VERSION & 0xFF);
+}
+
+TEST_F(ViaBulkTransfer, StalledWriteIsAborted) {
+    begin(id_bulk_write, id_bulk_dynamic_keymap, 0, 3 * PAYLOAD_SIZE);
+    write(std::vector<uint8_t>(PAYLOAD_SIZE, 0));
+    ASSERT_EQ(sent.size(), 1u);
+
+    // the rest of the data must not be taken for commands, such as id_bootloader_jump
+    advance_time(VIA_BULK_TRANSFER_TIMEOUT);
+    write(std::vector<uint8_t>(PAYLOAD_SIZE, id_bootloader_jump));
+    ASSERT_EQ(sent.size(), 2u);
+    expectStatus(sent[1], id_bulk_aborted, crc16(std::vector<uint8_t>(PAYLOAD_SIZE, 0).data(), PAYLOAD_SIZE));
+
+    write(std::vector<uint8_t>(PAYLOAD_SIZE, id_dynamic_keymap_reset));
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), 0);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, MATRIX_ROWS - 1, MATRIX_COLS - 1), KC_NO);
+
+    receive({id_get_protocol_version});
+    ASSERT_EQ(sent.size(), 3u);
+    EXPECT_EQ(sent[2][0], id_get_protocol_version);
+}
+
+TEST_F(ViaBulkTransfer, CommandsDuringWriteAreAnswered) {
+    std::vector<uint8_t> data(2 * PAYLOAD_SIZE, 0x21);
+    uint16_t             crc = crc16(data.data(), data.size());
+
+    begin(id_bulk_write, id_bulk_dynamic_keymap, 0, data.size(), crc);
+    write(std::vector<uint8_t>(data.begin(), data.begin() + PAYLOAD_SIZE));
+    receive({id_get_protocol_version});
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_EQ(sent[1][0], id_get_protocol_version);
+
+    write(std::vector<uint8_t>(data.begin() + PAYLOAD_SIZE, data.end()));
+    ASSERT_EQ(sent.size(), 3u);
+    expectStatus(sent[2], id_bulk_ok, crc);
+}
@@ -0,0 +1,76 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "wpm.h"
+void advance_time(uint32_t ms);
+}
+
+class Wpm : public TestFixture {
+   protected:
+    void SetUp() override {
+        // forget the keystrokes of the previous test
+        advance_time(WPM_SAMPLE_WINDOW + 1);
+        decay_wpm();
+    }
+
+    // one keystroke every interval milliseconds
+    void type(uint8_t count, uint16_t interval) {
+        for (uint8_t i = 0; i < count; i++) {
+            advance_time(interval);
+            update_wpm(KC_A);
+        }
+    }
+};
+
+TEST_F(Wpm, StartsAtZero) { EXPECT_EQ(get_current_wpm(), 0); }
+
+TEST_F(Wpm, SteadyTyping) {
+    // 5 keystrokes per second are 300 characters or 60 words per minute
+    type(10, 200);
+    EXPECT_EQ(get_current_wpm(), 60);
+}
+
+TEST_F(Wpm, IgnoresOtherKeycodes) {
+    type(5, 200);
+    advance_time(200);
+    update_wpm(KC_F1);
+    EXPECT_EQ(get_current_wpm(), 60);
+}
+
+TEST_F(Wpm, DecaysAndExpiresWhenIdle) {
+    type(10, 200);
+    advance_time(1000);
+    decay_wpm();
+    EXPECT_EQ(get_current_wpm(), 30);
+
+    advance_time(WPM_SAMPLE_WINDOW);
+    decay_wpm();
+    EXPECT_EQ(get_current_wpm(), 0);
+}
+
+TEST_F(Wpm, LimitedToSampleCount) {
+    // the buffer keeps the latest keystrokes, so fast typing is still measured
+    type(3 * WPM_SAMPLE_COUNT, 50);
+    EXPECT_EQ(get_current_wpm(), 240);
+}
+
+TEST_F(Wpm, SaturatesAt255) {
+    type(10, 10);
+    EXPECT_EQ(get_current_wpm(), 255);
+}
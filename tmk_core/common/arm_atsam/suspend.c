@@ -2,6 +2,7 @@
 #include "i2c_master.h"
 #include "md_rgb_matrix.h"
 #include "suspend.h"
+#include "eeconfig.h"
 
 /** \brief Suspend idle
  *
@@ -27,6 +28,9 @@ __attribute__((weak)) void suspend_power_down_kb(void) { suspend_power_down_user
  * FIXME: needs doc
  */
 void suspend_power_down(void) {
+#ifdef EECONFIG_WRITE_BACK
+    eeconfig_flush();
+#endif
 #ifdef RGB_MATRIX_ENABLE
     I2C3733_Control_Set(0);  // Disable LED driver
 #endif
@@ -8,6 +8,7 @@
 #include "timer.h"
 #include "led.h"
 #include "host.h"
+#include "eeconfig.h"
 
 #ifdef PROTOCOL_LUFA
 #    include "lufa.h"
@@ -135,6 +136,11 @@ void suspend_power_down(void) {
     if (!vusb_suspended) return;
 #endif
 
+#ifdef EECONFIG_WRITE_BACK
+    // Commit pending settings, the host may cut power while suspended
+    eeconfig_flush();
+#endif
+
     suspend_power_down_kb();
 
 #ifndef NO_SUSPEND_POWER_DOWN
@@ -20,6 +20,7 @@
 
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 #include "util.h"
 #include "debug.h"
 #include "eeprom_stm32.h"
@@ -53,6 +54,8 @@
  *
  * FEE_DENSITY_PAGES   # Total number of pages to use for eeprom simulation (Compact + Write log)
  * FEE_DENSITY_BYTES   # Size of simulated eeprom. (Defaults to half the space allocated by FEE_DENSITY_PAGES)
+ * FEE_WRITE_BACK      # Only update the cache on writes, and write the changes to flash later (see below)
+ * FEE_WRITE_BACK_DELAY # Milliseconds without writes before EEPROM_Task() flushes the cache (Defaults to 1000)
  * NOTE: The current implementation does not include page swapping,
  * and FEE_DENSITY_BYTES will consume that amount of RAM as a cached view of actual EEPROM contents.
  *
@@ -80,6 +83,22 @@
  * Otherwise a Write log entry is constructed and appended to the next free position in the Write log.
  *
  *
+ * *** Write-back ***
+ *
+ * With FEE_WRITE_BACK, writes only update the cache and mark the changed words dirty.
+ * EEPROM_Flush() writes all dirty words in one go, either from EEPROM_Task() once no write happened
+ * for FEE_WRITE_BACK_DELAY milliseconds, or before suspending or jumping to the bootloader:
+ * Dirty words whose Compacted-flash area is unprogrammed are written there directly.
+ * Runs of 3 or more consecutive dirty words are appended as a single Word-Run entry.
+ * If the dirty words don't fit in the remaining write log, the write log is compacted once instead.
+ * Writes made since the last flush are lost on a power cut, so repeated writes to the same address,
+ * like a VIA keymap upload or a series of RGB adjustments, only reach flash once.
+ *
+ * Every time the flash pages are erased, an Erase-Count entry is written at the start of the write log.
+ * Since all pages are erased together, it is the number of erase cycles each page went through,
+ * available from EEPROM_GetEraseCount().
+ *
+ *
  * *** Write Log Structure ***
  *
  * Write log entries allow for optimized byte writes to addresses below 128. Writing 0 or 1 words are also optimized when word-aligned.
@@ -109,9 +128,20 @@
  * ╚════════════════╝
  * 0 <= Address <= 0x3FFE (16382)
  *
- * ╔═══ Reserved ═══╗
- * ║110XXXXXXXXXXXXX║
- * ╚════════════════╝
+ * ╔═══════════════════════ Word-Run (FEE_WRITE_BACK) ════════════════════════╗
+ * ║110XXXXXXXXXXXXX║YYYYYYYYYYYYYYYY║ZZZZZZZZZZZZZZZZ...║CCCCCCCCCCCCCCCC║
+ * ║  └─────┬──────┘║└───────┬──────┘║└───────┬─────────║└───────┬──────┘║
+ * ║  Address >> 1  ║     ~Count     ║  ~Value, Count x ║    Checksum    ║
+ * ╚════════════════╩════════════════╩══════════════════╩════════════════╝
+ * 0 <= Address <= 0x3FFE (16382)
+ * Checksum is the 16 bit sum of the preceding words of the entry, 0 if that is 0xFFFF.
+ * A run with a wrong checksum was interrupted and is skipped.
+ *
+ * ╔════ Erase-Count (FEE_WRITE_BACK) ═══╗
+ * ║1111111111000000║YYYYYYYYYYYYYYYY║
+ * ║                ║└───────┬──────┘║
+ * ║                ║  ~Erase count  ║
+ * ╚════════════════╩════════════════╝
  *
  * ╔═══════════ Word-Next ═══════════╗
  * ║111XXXXXXXXXXXXX║YYYYYYYYYYYYYYYY║
@@ -125,9 +155,10 @@
  * 0x0000 ... 0x7FFF - Byte-Entry;     address is (Entry & 0x7F00) >> 4; value is (Entry & 0xFF)
  * 0x8000 ... 0x9FFF - Word-Encoded 0; address is (Entry & 0x1FFF) << 1; value is 0
  * 0xA000 ... 0xBFFF - Word-Encoded 1; address is (Entry & 0x1FFF) << 1; value is 1
- * 0xC000 ... 0xDFFF - Reserved
+ * 0xC000 ... 0xDFFF - Word-Run;       address is (Entry & 0x1FFF) << 1; count is ~(Next_Entry); values follow
  * 0xE000 ... 0xFFBF - Word-Next;      address is (Entry & 0x1FFF) << 1 + 0x80; value is ~(Next_Entry)
- * 0xFFC0 ... 0xFFFE - Reserved
+ * 0xFFC0            - Erase-Count;    erase count is ~(Next_Entry)
+ * 0xFFC1 ... 0xFFFE - Reserved
  * 0xFFFF            - Unprogrammed
  *
  */
@@ -138,6 +169,9 @@
 #define FEE_VALUE_RESERVED 0x4000
 #define FEE_VALUE_ENCODED 0x2000
 #define FEE_BYTE_RANGE 0x80
+#define FEE_ERASE_COUNT 0xFFC0
+/* Shortest run of dirty words written as a Word-Run entry, shorter ones are cheaper as individual entries */
+#define FEE_RUN_MIN_WORDS 3
 
 // HACK ALERT. This definition may not match your processor
 // To Do. Work out correct value for EEPROM_PAGE_SIZE on the STM32F103CT6 etc
@@ -253,6 +287,19 @@ static uint8_t *DataBuf = (uint8_t *)WordBuf;
 /* Pointer to the first available slot within the write log */
 static uint16_t *empty_slot;
 
+#ifdef FEE_WRITE_BACK
+#    include "timer.h"
+#    ifndef FEE_WRITE_BACK_DELAY
+#        define FEE_WRITE_BACK_DELAY 1000
+#    endif
+/* One bit per word of DataBuf that changed since it was last written to flash */
+static uint8_t  DirtyBuf[(FEE_DENSITY_BYTES / 2 + 7) / 8];
+static bool     dirty      = false;
+static uint32_t last_write = 0;
+/* Number of times the flash pages were erased, as read from and written to the write log */
+static uint16_t erase_count = 0;
+#endif
+
 // #define DEBUG_EEPROM_OUTPUT
 
 /*
@@ -311,6 +358,57 @@ void print_eeprom(void) {
 #endif
 }
 
+#ifdef FEE_WRITE_BACK
+static inline bool eeprom_is_dirty(uint16_t word) { return DirtyBuf[word / 8] & (1 << (word % 8)); }
+
+static inline void eeprom_mark_dirty(uint16_t Address) {
+    uint16_t word = Address / 2;
+    DirtyBuf[word / 8] |= 1 << (word % 8);
+    dirty      = true;
+    last_write = timer_read32();
+}
+
+static uint16_t eeprom_run_checksum(const uint16_t *entry, uint16_t count) {
+    uint16_t checksum = 0;
+    for (uint16_t i = 0; i < count + 2; ++i) {
+        checksum += entry[i];
+    }
+    /* Keep 0xFFFF for an unprogrammed checksum */
+    return checksum == FEE_EMPTY_WORD ? 0 : checksum;
+}
+
+/* Apply a Word-Run entry to the cache, returns the address of its last word */
+static uint16_t *eeprom_replay_run(uint16_t *log_addr) {
+    uint16_t *log_last = (uint16_t *)FEE_WRITE_LOG_LAST_ADDRESS;
+    uint16_t  address  = (*log_addr & 0x1FFF) << 1;
+
+    if (log_addr + 1 >= log_last) {
+        return log_addr;
+    }
+    if (log_addr[1] == FEE_EMPTY_WORD) {
+        /* Interrupted before the count was written. Skip the count slot, so it isn't reused */
+        eeprom_printf("Incomplete run at log_addr: 0x%04x;\n", (uint32_t)log_addr);
+        return log_addr + 1;
+    }
+
+    uint16_t count = ~log_addr[1];
+    if (log_addr + count + 2 >= log_last) {
+        eeprom_printf("Run past the write log at log_addr: 0x%04x;\n", (uint32_t)log_addr);
+        return log_last - 1;
+    }
+    if (log_addr[count + 2] != eeprom_run_checksum(log_addr, count) || address + count * 2 > FEE_DENSITY_BYTES) {
+        eeprom_printf("Incomplete run at log_addr: 0x%04x;\n", (uint32_t)log_addr);
+        return log_addr + count + 2;
+    }
+
+    eeprom_printf("DataBuf[0x%04x...0x%04x] = run;\n", address, address + count * 2 - 1);
+    for (uint16_t i = 0; i < count; ++i) {
+        WordBuf[address / 2 + i] = ~log_addr[i + 2];
+    }
+    return log_addr + count + 2;
+}
+#endif
+
 uint16_t EEPROM_Init(void) {
     /* Load emulated eeprom contents from compacted flash into memory */
     uint16_t *src  = (uint16_t *)FEE_PAGE_BASE_ADDRESS;
@@ -325,6 +423,12 @@ uint16_t EEPROM_Init(void) {
         println("EEPROM_Init Write Log:");
     }
 
+#ifdef FEE_WRITE_BACK
+    memset(DirtyBuf, 0, sizeof(DirtyBuf));
+    dirty       = false;
+    erase_count = 0;
+#endif
+
     /* Replay write log */
     uint16_t *log_addr;
     for (log_addr = (uint16_t *)FEE_WRITE_LOG_BASE_ADDRESS; log_addr < (uint16_t *)FEE_WRITE_LOG_LAST_ADDRESS; ++log_addr) {
@@ -338,6 +442,17 @@ uint16_t EEPROM_Init(void) {
             address >>= 8;
             DataBuf[address] = bvalue;
             eeprom_printf("DataBuf[0x%02x] = 0x%02x;\n", address, bvalue);
+#ifdef FEE_WRITE_BACK
+        } else if (address == FEE_ERASE_COUNT) {
+            if (++log_addr >= (uint16_t *)FEE_WRITE_LOG_LAST_ADDRESS) {
+                break;
+            }
+            erase_count = ~*log_addr;
+            eeprom_printf("erase_count = %d;\n", erase_count);
+        } else if ((address & FEE_VALUE_NEXT) == FEE_VALUE_RESERVED) {
+            /* Skip to the last word of the run, whether it was complete or not */
+            log_addr = eeprom_replay_run(log_addr);
+#endif
         } else {
             uint16_t wvalue;
             /* Check if value is in next word */
@@ -395,9 +510,17 @@ static void eeprom_clear(void) {
         FLASH_ErasePage(FEE_PAGE_BASE_ADDRESS + (page_num * FEE_PAGE_SIZE));
     }
 
+    empty_slot = (uint16_t *)FEE_WRITE_LOG_BASE_ADDRESS;
+
+#ifdef FEE_WRITE_BACK
+    /* Carry the erase count over to the fresh write log */
+    if (erase_count < UINT16_MAX) ++erase_count;
+    FLASH_ProgramHalfWord((uintptr_t)empty_slot++, FEE_ERASE_COUNT);
+    FLASH_ProgramHalfWord((uintptr_t)empty_slot++, ~erase_count);
+#endif
+
     FLASH_Lock();
 
-    empty_slot = (uint16_t *)FEE_WRITE_LOG_BASE_ADDRESS;
     eeprom_printf("eeprom_clear empty_slot: 0x%08x\n", (uint32_t)empty_slot);
 }
 
@@ -551,6 +674,12 @@ uint8_t EEPROM_WriteDataByte(uint16_t Address, uint8_t DataByte) {
     DataBuf[Address] = DataByte;
     eeprom_printf("EEPROM_WriteDataByte DataBuf[0x%04x] = 0x%02x\n", Address, DataBuf[Address]);
 
+#ifdef FEE_WRITE_BACK
+    /* written to flash by EEPROM_Flush() */
+    eeprom_mark_dirty(Address);
+    return FLASH_COMPLETE;
+#endif
+
     /* perform the write into flash memory */
     /* First, attempt to write directly into the compacted flash area */
     FLASH_Status status = eeprom_write_direct_entry(Address);
@@ -598,6 +727,12 @@ uint8_t EEPROM_WriteDataWord(uint16_t Address, uint16_t DataWord) {
     *(uint16_t *)(&DataBuf[Address]) = DataWord;
     eeprom_printf("EEPROM_WriteDataWord DataBuf[0x%04x] = 0x%04x\n", Address, *(uint16_t *)(&DataBuf[Address]));
 
+#ifdef FEE_WRITE_BACK
+    /* written to flash by EEPROM_Flush() */
+    eeprom_mark_dirty(Address);
+    return FLASH_COMPLETE;
+#endif
+
     /* perform the write into flash memory */
     /* First, attempt to write directly into the compacted flash area */
     final_status = eeprom_write_direct_entry(Address);
@@ -626,6 +761,121 @@ uint8_t EEPROM_WriteDataWord(uint16_t Address, uint16_t DataWord) {
     return final_status;
 }
 
+#ifdef FEE_WRITE_BACK
+static uint8_t eeprom_write_log_run_entry(uint16_t word, uint16_t count) {
+    eeprom_printf("eeprom_write_log_run_entry(0x%04x, %d)\n", word * 2, count);
+
+    uint16_t header   = FEE_WORD_ENCODING | FEE_VALUE_RESERVED | word;
+    uint16_t checksum = header + (uint16_t)~count;
+
+    FLASH_Unlock();
+
+    FLASH_Status final_status = FLASH_ProgramHalfWord((uintptr_t)empty_slot++, header);
+    FLASH_Status status       = FLASH_ProgramHalfWord((uintptr_t)empty_slot++, ~count);
+    if (status != FLASH_COMPLETE) final_status = status;
+
+    for (uint16_t i = 0; i < count; ++i) {
+        uint16_t value = ~WordBuf[word + i];
+        checksum += value;
+        status = FLASH_ProgramHalfWord((uintptr_t)empty_slot++, value);
+        if (status != FLASH_COMPLETE) final_status = status;
+    }
+
+    /* Written last, so an interrupted run is recognized and skipped */
+    status = FLASH_ProgramHalfWord((uintptr_t)empty_slot++, checksum == FEE_EMPTY_WORD ? 0 : checksum);
+    if (status != FLASH_COMPLETE) final_status = status;
+
+    FLASH_Lock();
+
+    return final_status;
+}
+
+/* Number of consecutive dirty words from word on that have to go through the write log */
+static uint16_t eeprom_dirty_log_run(uint16_t word) {
+    uint16_t end = word;
+    while (end < FEE_DENSITY_BYTES / 2 && eeprom_is_dirty(end) && ((uint16_t *)FEE_PAGE_BASE_ADDRESS)[end] != FEE_EMPTY_WORD) {
+        ++end;
+    }
+    return end - word;
+}
+
+/* Write the dirty words to flash, or with measure_only, return how many write log words that takes */
+static uint32_t eeprom_flush_dirty(bool measure_only, FLASH_Status *final_status) {
+    uint32_t log_words = 0;
+
+    for (uint16_t word = 0; word < FEE_DENSITY_BYTES / 2;) {
+        if (!eeprom_is_dirty(word)) {
+            ++word;
+            continue;
+        }
+
+        uint16_t     run    = eeprom_dirty_log_run(word);
+        FLASH_Status status = FLASH_COMPLETE;
+        if (!run) {
+            /* The Compacted-flash area for this word is unprogrammed */
+            if (!measure_only) status = eeprom_write_direct_entry(word * 2);
+            run = 1;
+        } else if (run >= FEE_RUN_MIN_WORDS) {
+            log_words += run + 3;
+            if (!measure_only) status = eeprom_write_log_run_entry(word, run);
+        } else if (word * 2 < FEE_BYTE_RANGE) {
+            log_words += 2;
+            if (!measure_only) {
+                status = eeprom_write_log_byte_entry(word * 2);
+                if (status == FLASH_COMPLETE) status = eeprom_write_log_byte_entry(word * 2 + 1);
+            }
+            run = 1;
+        } else {
+            log_words += WordBuf[word] <= 1 ? 1 : 2;
+            if (!measure_only) status = eeprom_write_log_word_entry(word * 2);
+            run = 1;
+        }
+
+        if (status != FLASH_COMPLETE) *final_status = status;
+        word += run;
+    }
+
+    return log_words;
+}
+#endif
+
+/* Write everything changed since the last flush to flash */
+uint8_t EEPROM_Flush(void) {
+    FLASH_Status final_status = FLASH_COMPLETE;
+#ifdef FEE_WRITE_BACK
+    if (!dirty) return final_status;
+
+    if (eeprom_flush_dirty(true, &final_status) > (uint32_t)((uint16_t *)FEE_WRITE_LOG_LAST_ADDRESS - empty_slot)) {
+        /* Doesn't fit in the write log: compact once, which writes the whole cache */
+        eeprom_printf("EEPROM_Flush [COMPACT]\n");
+        final_status = eeprom_compact();
+    } else {
+        eeprom_flush_dirty(false, &final_status);
+    }
+
+    memset(DirtyBuf, 0, sizeof(DirtyBuf));
+    dirty = false;
+
+    if (final_status != FLASH_COMPLETE) {
+        eeprom_printf("EEPROM_Flush [STATUS == %d]\n", final_status);
+    }
+#endif
+    return final_status;
+}
+
+/* Flush once writes have settled, call from the main loop */
+void EEPROM_Task(void) {
+#ifdef FEE_WRITE_BACK
+    if (dirty && timer_elapsed32(last_write) >= FEE_WRITE_BACK_DELAY) {
+        EEPROM_Flush();
+    }
+#endif
+}
+
+#ifdef FEE_WRITE_BACK
+uint16_t EEPROM_GetEraseCount(void) { return erase_count; }
+#endif
+
 uint8_t EEPROM_ReadDataByte(uint16_t Address) {
     uint8_t DataByte = 0xFF;
 
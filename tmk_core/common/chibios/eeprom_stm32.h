@@ -29,5 +29,10 @@ uint8_t  EEPROM_WriteDataByte(uint16_t Address, uint8_t DataByte);
 uint8_t  EEPROM_WriteDataWord(uint16_t Address, uint16_t DataWord);
 uint8_t  EEPROM_ReadDataByte(uint16_t Address);
 uint16_t EEPROM_ReadDataWord(uint16_t Address);
+uint8_t  EEPROM_Flush(void);
+void     EEPROM_Task(void);
+#ifdef FEE_WRITE_BACK
+uint16_t EEPROM_GetEraseCount(void);
+#endif
 
 void print_eeprom(void);
@@ -31,6 +31,14 @@
 #    include "rgb_matrix.h"
 #endif
 
+#ifdef EECONFIG_WRITE_BACK
+#    include "eeconfig.h"
+#endif
+
+#ifdef STM32_EEPROM_ENABLE
+#    include "eeprom_stm32.h"
+#endif
+
 /** \brief suspend idle
  *
  * FIXME: needs doc
@@ -56,6 +64,13 @@ __attribute__((weak)) void suspend_power_down_kb(void) { suspend_power_down_user
  * FIXME: needs doc
  */
 void suspend_power_down(void) {
+#ifdef EECONFIG_WRITE_BACK
+    eeconfig_flush();
+#endif
+#ifdef STM32_EEPROM_ENABLE
+    // Don't leave cached settings behind if the host cuts power while suspended
+    EEPROM_Flush();
+#endif
 #ifdef BACKLIGHT_ENABLE
     backlight_set(0);
 #endif
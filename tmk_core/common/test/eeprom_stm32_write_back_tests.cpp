@@ -0,0 +1,187 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "flash_stm32.h"
+#include "eeprom_stm32.h"
+#include "eeprom.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+/* Same tiny layout as eeprom_stm32_tiny, with FEE_WRITE_BACK:
+ * 256 bytes of simulated EEPROM followed by a 256 byte write log,
+ * which starts with the Erase-Count entry. */
+
+#define EEPROM_SIZE (FEE_PAGE_SIZE * FEE_DENSITY_PAGES / 2)
+#define LOG_SIZE EEPROM_SIZE
+#define LOG_BASE (MOCK_FLASH_SIZE - LOG_SIZE)
+#define EEPROM_BASE (LOG_BASE - EEPROM_SIZE)
+#define LOG_FIRST_ENTRY (LOG_BASE + 4)
+
+#define FLASH_WORD(offset) (*(uint16_t*)&FlashBuf[offset])
+
+/* Log encoding helpers */
+#define WORD_NEXT(addr) (0xE000 | (((addr)-0x80) >> 1))
+#define WORD_RUN(addr) (0xC000 | ((addr) >> 1))
+
+class EepromStm32WriteBackTest : public testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        EEPROM_Erase();
+    }
+
+    /* Program the Compacted-flash area of the given words, so later writes go to the write log */
+    void program_compacted(uint16_t address, uint16_t words) {
+        for (uint16_t i = 0; i < words; ++i) {
+            EEPROM_WriteDataWord(address + i * 2, 0x1111);
+        }
+        EEPROM_Flush();
+        ASSERT_EQ(FLASH_WORD(LOG_FIRST_ENTRY), 0xFFFF);
+    }
+};
+
+TEST_F(EepromStm32WriteBackTest, WritesStayInCacheUntilFlushed) {
+    EEPROM_WriteDataByte(0x90, 0x12);
+    EXPECT_EQ(EEPROM_ReadDataByte(0x90), 0x12);
+    EXPECT_EQ(FLASH_WORD(EEPROM_BASE + 0x90), 0xFFFF);
+
+    /* Power cycle before the flush */
+    EEPROM_Init();
+    EXPECT_EQ(EEPROM_ReadDataByte(0x90), 0);
+
+    EEPROM_WriteDataByte(0x90, 0x12);
+    EXPECT_EQ(EEPROM_Flush(), FLASH_COMPLETE);
+    EEPROM_Init();
+    EXPECT_EQ(EEPROM_ReadDataByte(0x90), 0x12);
+}
+
+TEST_F(EepromStm32WriteBackTest, FlushWritesToUnprogrammedCompactedArea) {
+    EEPROM_WriteDataWord(0x90, 0xbeef);
+    EEPROM_WriteDataWord(0x10, 0x1234);
+    EEPROM_Flush();
+
+    EXPECT_EQ(FLASH_WORD(EEPROM_BASE + 0x90), (uint16_t)~0xbeef);
+    EXPECT_EQ(FLASH_WORD(EEPROM_BASE + 0x10), (uint16_t)~0x1234);
+    EXPECT_EQ(FLASH_WORD(LOG_FIRST_ENTRY), 0xFFFF);
+}
+
+TEST_F(EepromStm32WriteBackTest, RunOfDirtyWordsIsOneLogEntry) {
+    program_compacted(0x80, 8);
+
+    uint8_t block[16];
+    for (int i = 0; i < 16; ++i) block[i] = 0xa0 + i;
+    eeprom_update_block(block, (void*)0x80, sizeof(block));
+    EEPROM_Flush();
+
+    EXPECT_EQ(FLASH_WORD(LOG_FIRST_ENTRY), WORD_RUN(0x80));
+    EXPECT_EQ(FLASH_WORD(LOG_FIRST_ENTRY + 2), (uint16_t)~8);
+    EXPECT_EQ(FLASH_WORD(LOG_FIRST_ENTRY + 4), (uint16_t)~0xa1a0);
+    EXPECT_EQ(FLASH_WORD(LOG_FIRST_ENTRY + 18), (uint16_t)~0xafae);
+    /* Header, count, 8 values and the checksum */
+    EXPECT_EQ(FLASH_WORD(LOG_FIRST_ENTRY + 22), 0xFFFF);
+
+    EEPROM_Init();
+    uint8_t read[16];
+    eeprom_read_block(read, (void*)0x80, sizeof(read));
+    EXPECT_EQ(memcmp(block, read, sizeof(block)), 0);
+}
+
+TEST_F(EepromStm32WriteBackTest, RepeatedWritesAreCoalesced) {
+    program_compacted(0x90, 1);
+
+    for (uint16_t value = 2; value < 100; ++value) {
+        EEPROM_WriteDataWord(0x90, value);
+    }
+    EEPROM_Flush();
+
+    EXPECT_EQ(FLASH_WORD(LOG_FIRST_ENTRY), WORD_NEXT(0x90));
+    EXPECT_EQ(FLASH_WORD(LOG_FIRST_ENTRY + 2), (uint16_t)~99);
+    EXPECT_EQ(FLASH_WORD(LOG_FIRST_ENTRY + 4), 0xFFFF);
+}
+
+TEST_F(EepromStm32WriteBackTest, FlushThatDoesNotFitCompactsOnce) {
+    program_compacted(0, EEPROM_SIZE / 2);
+
+    uint16_t erase_count = EEPROM_GetEraseCount();
+    for (uint16_t address = 0; address < EEPROM_SIZE; address += 2) {
+        EEPROM_WriteDataWord(address, 0x4000 + address);
+    }
+    EXPECT_EQ(EEPROM_Flush(), FLASH_COMPLETE);
+    EXPECT_EQ(EEPROM_GetEraseCount(), erase_count + 1);
+
+    EEPROM_Init();
+    EXPECT_EQ(EEPROM_GetEraseCount(), erase_count + 1);
+    for (uint16_t address = 0; address < EEPROM_SIZE; address += 2) {
+        EXPECT_EQ(EEPROM_ReadDataWord(address), 0x4000 + address);
+    }
+}
+
+TEST_F(EepromStm32WriteBackTest, InterruptedRunIsSkipped) {
+    program_compacted(0x80, 4);
+
+    for (uint16_t address = 0x80; address < 0x88; address += 2) {
+        EEPROM_WriteDataWord(address, 0x2222);
+    }
+    EEPROM_Flush();
+    /* Power lost before the checksum was written */
+    FLASH_WORD(LOG_FIRST_ENTRY + 12) = 0xFFFF;
+
+    EEPROM_Init();
+    EXPECT_EQ(EEPROM_ReadDataWord(0x80), 0x1111);
+    EXPECT_EQ(EEPROM_ReadDataWord(0x86), 0x1111);
+
+    /* Later writes are appended after the broken run */
+    EEPROM_WriteDataWord(0x80, 0x3333);
+    EEPROM_Flush();
+    EXPECT_EQ(FLASH_WORD(LOG_FIRST_ENTRY + 14), WORD_NEXT(0x80));
+    EEPROM_Init();
+    EXPECT_EQ(EEPROM_ReadDataWord(0x80), 0x3333);
+    EXPECT_EQ(EEPROM_ReadDataWord(0x82), 0x1111);
+}
+
+TEST_F(EepromStm32WriteBackTest, TaskFlushesAfterQuietPeriod) {
+    EEPROM_WriteDataWord(0x90, 0xbeef);
+    advance_time(FEE_WRITE_BACK_DELAY - 1);
+    EEPROM_Task();
+    EXPECT_EQ(FLASH_WORD(EEPROM_BASE + 0x90), 0xFFFF);
+
+    /* Another write restarts the quiet period */
+    EEPROM_WriteDataWord(0x92, 0xcafe);
+    advance_time(FEE_WRITE_BACK_DELAY - 1);
+    EEPROM_Task();
+    EXPECT_EQ(FLASH_WORD(EEPROM_BASE + 0x90), 0xFFFF);
+
+    advance_time(1);
+    EEPROM_Task();
+    EXPECT_EQ(FLASH_WORD(EEPROM_BASE + 0x90), (uint16_t)~0xbeef);
+    EXPECT_EQ(FLASH_WORD(EEPROM_BASE + 0x92), (uint16_t)~0xcafe);
+}
+
+TEST_F(EepromStm32WriteBackTest, EraseCountSurvivesErase) {
+    uint16_t erase_count = EEPROM_GetEraseCount();
+    EXPECT_GT(erase_count, 0);
+    EXPECT_EQ(FLASH_WORD(LOG_BASE), 0xFFC0);
+
+    EEPROM_Erase();
+    EXPECT_EQ(EEPROM_GetEraseCount(), erase_count + 1);
+    EEPROM_Init();
+    EXPECT_EQ(EEPROM_GetEraseCount(), erase_count + 1);
+}
@@ -9,11 +9,15 @@ eeprom_stm32_large_DEFS := $(eeprom_stm32_DEFS) \
 	-DMOCK_FLASH_SIZE=65536 \
 	-DFEE_PAGE_SIZE=2048 \
 	-DFEE_DENSITY_PAGES=16
+eeprom_stm32_write_back_DEFS := $(eeprom_stm32_tiny_DEFS) \
+	-DFEE_WRITE_BACK \
+	-DFEE_WRITE_BACK_DELAY=100
 
 eeprom_stm32_INC := \
 	$(TMK_PATH)/common/chibios/
 eeprom_stm32_tiny_INC := $(eeprom_stm32_INC)
 eeprom_stm32_large_INC := $(eeprom_stm32_INC)
+eeprom_stm32_write_back_INC := $(eeprom_stm32_INC)
 
 eeprom_stm32_SRC := \
 	$(TMK_PATH)/common/test/eeprom_stm32_tests.cpp \
@@ -21,3 +25,8 @@ eeprom_stm32_SRC := \
 	$(TMK_PATH)/common/chibios/eeprom_stm32.c
 eeprom_stm32_tiny_SRC := $(eeprom_stm32_SRC)
 eeprom_stm32_large_SRC := $(eeprom_stm32_SRC)
+eeprom_stm32_write_back_SRC := \
+	$(TMK_PATH)/common/test/eeprom_stm32_write_back_tests.cpp \
+	$(TMK_PATH)/common/test/flash_stm32_mock.c \
+	$(TMK_PATH)/common/test/timer.c \
+	$(TMK_PATH)/common/chibios/eeprom_stm32.c
@@ -447,6 +447,153 @@ void usb_event_queue_task(void) {
     }
 }
 
+#ifdef USB_REPORT_SCHEDULER
+/* ---------------------------------------------------------
+ *                  Report scheduler
+ * ---------------------------------------------------------
+ */
+/* Reports are copied into a small queue per endpoint instead of being sent from the
+ * caller's buffer, so sending never has to wait for the previous transfer: the next
+ * queued report is started from the IN callback as soon as the host has picked up the
+ * previous one, with the SOF callback as a fallback. Only a full queue makes the caller wait.
+ */
+
+#    ifndef USB_REPORT_QUEUE_SIZE
+#        define USB_REPORT_QUEUE_SIZE 4
+#    endif
+
+/* every report that goes through a queue has to fit a slot */
+#    define REPORT_QUEUE_SLOT_SIZE sizeof(report_keyboard_t)
+_Static_assert(sizeof(report_mouse_t) <= REPORT_QUEUE_SLOT_SIZE, "report_mouse_t does not fit a report queue slot");
+_Static_assert(sizeof(report_extra_t) <= REPORT_QUEUE_SLOT_SIZE, "report_extra_t does not fit a report queue slot");
+_Static_assert(sizeof(report_digitizer_t) <= REPORT_QUEUE_SLOT_SIZE, "report_digitizer_t does not fit a report queue slot");
+
+typedef struct {
+    uint8_t data[USB_REPORT_QUEUE_SIZE][REPORT_QUEUE_SLOT_SIZE];
+    uint8_t size[USB_REPORT_QUEUE_SIZE];
+    uint8_t head;
+    uint8_t count;
+    bool    in_flight; /* the report at head is being transmitted */
+} report_queue_t;
+
+/* folds a report into the last queued one, returns false if both have to be sent */
+typedef bool (*report_merge_t)(uint8_t *queued, const uint8_t *report, uint8_t size);
+
+#    ifndef KEYBOARD_SHARED_EP
+static report_queue_t keyboard_queue;
+#    endif
+#    if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP)
+static report_queue_t mouse_queue;
+#    endif
+#    ifdef SHARED_EP_ENABLE
+static report_queue_t shared_queue;
+#    endif
+
+static report_queue_t *report_queue_for(usbep_t ep) {
+#    ifndef KEYBOARD_SHARED_EP
+    if (ep == KEYBOARD_IN_EPNUM) return &keyboard_queue;
+#    endif
+#    if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP)
+    if (ep == MOUSE_IN_EPNUM) return &mouse_queue;
+#    endif
+#    ifdef SHARED_EP_ENABLE
+    if (ep == SHARED_IN_EPNUM) return &shared_queue;
+#    endif
+    return NULL;
+}
+
+/* drops everything queued: the endpoints have been (re)initialized, or the bus was suspended or reset
+ * and a transfer that was in flight will never complete, nor should stale reports go out afterwards */
+static void report_queues_resetI(void) {
+#    ifndef KEYBOARD_SHARED_EP
+    memset(&keyboard_queue, 0, sizeof(report_queue_t));
+#    endif
+#    if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP)
+    memset(&mouse_queue, 0, sizeof(report_queue_t));
+#    endif
+#    ifdef SHARED_EP_ENABLE
+    memset(&shared_queue, 0, sizeof(report_queue_t));
+#    endif
+}
+
+/* starts transmitting the oldest queued report, if the endpoint is free */
+static void report_queue_kickI(USBDriver *usbp, usbep_t ep) {
+    report_queue_t *queue = report_queue_for(ep);
+    if (queue == NULL || queue->in_flight || queue->count == 0) return;
+    if (usbGetDriverStateI(usbp) != USB_ACTIVE || usbGetTransmitStatusI(usbp, ep)) return;
+
+    queue->in_flight = true;
+    usbStartTransmitI(usbp, ep, queue->data[queue->head], queue->size[queue->head]);
+}
+
+/* a report has made it IN: free its slot and start the next one (called from ISR, unlocked state) */
+static void report_queue_in_cb(USBDriver *usbp, usbep_t ep) {
+    osalSysLockFromISR();
+    report_queue_t *queue = report_queue_for(ep);
+    if (queue != NULL && queue->in_flight) {
+        queue->in_flight = false;
+        queue->head      = (queue->head + 1) % USB_REPORT_QUEUE_SIZE;
+        queue->count--;
+    }
+    report_queue_kickI(usbp, ep);
+    osalSysUnlockFromISR();
+}
+
+/* queues a report for sending (locked state, not callable from ISR) */
+static void report_queue_sendS(usbep_t ep, const void *report, uint8_t size, report_merge_t merge) {
+    report_queue_t *queue = report_queue_for(ep);
+
+    if (queue->count > (queue->in_flight ? 1 : 0)) {
+        uint8_t last = (queue->head + queue->count - 1) % USB_REPORT_QUEUE_SIZE;
+        /* reports of the same size can still be of different types on the shared endpoint, where the first
+         * byte is the report ID; elsewhere it is the modifiers or buttons, which have to match to merge anyway */
+        if (merge != NULL && queue->size[last] == size && queue->data[last][0] == ((const uint8_t *)report)[0] && merge(queue->data[last], report, size)) {
+            return;
+        }
+    }
+
+    while (queue->count == USB_REPORT_QUEUE_SIZE) {
+        /* every slot is taken, wait for the host so no report gets lost or reordered */
+        if (osalThreadSuspendTimeoutS(&(&USB_DRIVER)->epc[ep]->in_state->thread, TIME_MS2I(10)) == MSG_TIMEOUT || usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE) {
+            return;
+        }
+    }
+
+    uint8_t slot = (queue->head + queue->count) % USB_REPORT_QUEUE_SIZE;
+    memcpy(queue->data[slot], report, size);
+    queue->size[slot] = size;
+    queue->count++;
+    report_queue_kickI(&USB_DRIVER, ep);
+}
+
+/* the host only cares about the state, an identical report changes nothing */
+static bool report_merge_identical(uint8_t *queued, const uint8_t *report, uint8_t size) { return memcmp(queued, report, size) == 0; }
+
+#    ifdef MOUSE_ENABLE
+static bool merge_motion(int8_t *queued, int8_t motion) {
+    int16_t sum = *queued + motion;
+    if (sum < -127 || sum > 127) return false;
+    *queued = sum;
+    return true;
+}
+
+/* movement with the same buttons can be sent as one report */
+static bool report_merge_mouse(uint8_t *queued, const uint8_t *report, uint8_t size) {
+    (void)size;
+    report_mouse_t *      queued_report = (report_mouse_t *)queued;
+    const report_mouse_t *mouse_report  = (const report_mouse_t *)report;
+    report_mouse_t        merged        = *queued_report;
+
+    if (merged.buttons != mouse_report->buttons) return false;
+    if (!merge_motion(&merged.x, mouse_report->x) || !merge_motion(&merged.y, mouse_report->y) || !merge_motion(&merged.v, mouse_report->v) || !merge_motion(&merged.h, mouse_report->h)) {
+        return false;
+    }
+    *queued_report = merged;
+    return true;
+}
+#    endif
+#endif /* USB_REPORT_SCHEDULER */
+
 /* Handles the USB driver global events
  * TODO: maybe disable some things when connection is lost? */
 static void usb_event_cb(USBDriver *usbp, usbevent_t event) {
@@ -457,6 +604,9 @@ static void usb_event_cb(USBDriver *usbp, usbevent_t event) {
         case USB_EVENT_CONFIGURED:
             osalSysLockFromISR();
             /* Enable the endpoints specified into the configuration. */
+#ifdef USB_REPORT_SCHEDULER
+            report_queues_resetI();
+#endif
 #ifndef KEYBOARD_SHARED_EP
             usbInitEndpointI(usbp, KEYBOARD_IN_EPNUM, &kbd_ep_config);
 #endif
@@ -489,6 +639,11 @@ static void usb_event_cb(USBDriver *usbp, usbevent_t event) {
         case USB_EVENT_UNCONFIGURED:
             /* Falls into.*/
         case USB_EVENT_RESET:
+#ifdef USB_REPORT_SCHEDULER
+            osalSysLockFromISR();
+            report_queues_resetI();
+            osalSysUnlockFromISR();
+#endif
             for (int i = 0; i < NUM_USB_DRIVERS; i++) {
                 chSysLockFromISR();
                 /* Disconnection event on suspend.*/
@@ -748,16 +903,37 @@ __attribute__((weak)) void restart_usb_driver(USBDriver *usbp) {
 /* keyboard IN callback hander (a kbd report has made it IN) */
 #ifndef KEYBOARD_SHARED_EP
 void kbd_in_cb(USBDriver *usbp, usbep_t ep) {
+#    ifdef USB_REPORT_SCHEDULER
+    report_queue_in_cb(usbp, ep);
+#    else
     /* STUB */
     (void)usbp;
     (void)ep;
+#    endif
 }
 #endif
 
 /* start-of-frame handler
  * TODO: i guess it would be better to re-implement using timers,
  *  so that this is not going to have to be checked every 1ms */
-void kbd_sof_cb(USBDriver *usbp) { (void)usbp; }
+void kbd_sof_cb(USBDriver *usbp) {
+#ifdef USB_REPORT_SCHEDULER
+    /* pick up anything the IN callbacks could not start */
+    osalSysLockFromISR();
+#    ifndef KEYBOARD_SHARED_EP
+    report_queue_kickI(usbp, KEYBOARD_IN_EPNUM);
+#    endif
+#    if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP)
+    report_queue_kickI(usbp, MOUSE_IN_EPNUM);
+#    endif
+#    ifdef SHARED_EP_ENABLE
+    report_queue_kickI(usbp, SHARED_IN_EPNUM);
+#    endif
+    osalSysUnlockFromISR();
+#else
+    (void)usbp;
+#endif
+}
 
 /* Idle requests timer code
  * callback (called from ISR, unlocked state) */
@@ -804,6 +980,9 @@ void send_keyboard(report_keyboard_t *report) {
 
 #ifdef NKRO_ENABLE
     if (keymap_config.nkro && keyboard_protocol) { /* NKRO protocol */
+#    ifdef USB_REPORT_SCHEDULER
+        report_queue_sendS(SHARED_IN_EPNUM, report, sizeof(struct nkro_report), report_merge_identical);
+#    else
         /* need to wait until the previous packet has made it through */
         /* can rewrite this using the synchronous API, then would wait
          * until *after* the packet has been transmitted. I think
@@ -822,9 +1001,21 @@ void send_keyboard(report_keyboard_t *report) {
             }
         }
         usbStartTransmitI(&USB_DRIVER, SHARED_IN_EPNUM, (uint8_t *)report, sizeof(struct nkro_report));
+#    endif
     } else
 #endif /* NKRO_ENABLE */
     {  /* regular protocol */
+        uint8_t *data, size;
+        if (keyboard_protocol) {
+            data = (uint8_t *)report;
+            size = KEYBOARD_REPORT_SIZE;
+        } else { /* boot protocol */
+            data = &report->mods;
+            size = 8;
+        }
+#ifdef USB_REPORT_SCHEDULER
+        report_queue_sendS(KEYBOARD_IN_EPNUM, data, size, report_merge_identical);
+#else
         /* need to wait until the previous packet has made it through */
         /* busy wait, should be short and not very common */
         if (usbGetTransmitStatusI(&USB_DRIVER, KEYBOARD_IN_EPNUM)) {
@@ -839,15 +1030,8 @@ void send_keyboard(report_keyboard_t *report) {
                 goto unlock;
             }
         }
-        uint8_t *data, size;
-        if (keyboard_protocol) {
-            data = (uint8_t *)report;
-            size = KEYBOARD_REPORT_SIZE;
-        } else { /* boot protocol */
-            data = &report->mods;
-            size = 8;
-        }
         usbStartTransmitI(&USB_DRIVER, KEYBOARD_IN_EPNUM, data, size);
+#endif
     }
     keyboard_report_sent = *report;
 
@@ -865,8 +1049,12 @@ unlock:
 #    ifndef MOUSE_SHARED_EP
 /* mouse IN callback hander (a mouse report has made it IN) */
 void mouse_in_cb(USBDriver *usbp, usbep_t ep) {
+#        ifdef USB_REPORT_SCHEDULER
+    report_queue_in_cb(usbp, ep);
+#        else
     (void)usbp;
     (void)ep;
+#        endif
 }
 #    endif
 
@@ -877,6 +1065,9 @@ void send_mouse(report_mouse_t *report) {
         return;
     }
 
+#    ifdef USB_REPORT_SCHEDULER
+    report_queue_sendS(MOUSE_IN_EPNUM, report, sizeof(report_mouse_t), report_merge_mouse);
+#    else
     if (usbGetTransmitStatusI(&USB_DRIVER, MOUSE_IN_EPNUM)) {
         /* Need to either suspend, or loop and call unlock/lock during
          * every iteration - otherwise the system will remain locked,
@@ -888,6 +1079,7 @@ void send_mouse(report_mouse_t *report) {
         }
     }
     usbStartTransmitI(&USB_DRIVER, MOUSE_IN_EPNUM, (uint8_t *)report, sizeof(report_mouse_t));
+#    endif
     osalSysUnlock();
 }
 
@@ -902,9 +1094,13 @@ void send_mouse(report_mouse_t *report) { (void)report; }
 #ifdef SHARED_EP_ENABLE
 /* shared IN callback hander */
 void shared_in_cb(USBDriver *usbp, usbep_t ep) {
+#    ifdef USB_REPORT_SCHEDULER
+    report_queue_in_cb(usbp, ep);
+#    else
     /* STUB */
     (void)usbp;
     (void)ep;
+#    endif
 }
 #endif
 
@@ -924,7 +1120,11 @@ static void send_extra(uint8_t report_id, uint16_t data) {
     static report_extra_t report;
     report = (report_extra_t){.report_id = report_id, .usage = data};
 
+#    ifdef USB_REPORT_SCHEDULER
+    report_queue_sendS(SHARED_IN_EPNUM, &report, sizeof(report_extra_t), NULL);
+#    else
     usbStartTransmitI(&USB_DRIVER, SHARED_IN_EPNUM, (uint8_t *)&report, sizeof(report_extra_t));
+#    endif
     osalSysUnlock();
 }
 #endif
@@ -950,7 +1150,11 @@ void send_digitizer(report_digitizer_t *report) {
         return;
     }
 
+#        ifdef USB_REPORT_SCHEDULER
+    report_queue_sendS(DIGITIZER_IN_EPNUM, report, sizeof(report_digitizer_t), report_merge_identical);
+#        else
     usbStartTransmitI(&USB_DRIVER, DIGITIZER_IN_EPNUM, (uint8_t *)report, sizeof(report_digitizer_t));
+#        endif
     osalSysUnlock();
 #    else
     chnWrite(&drivers.digitizer_driver.driver, (uint8_t *)report, sizeof(report_digitizer_t));
@@ -189,11 +189,14 @@ void raw_hid_send(uint8_t *data, uint8_t length) {
 
     // TODO: decide if we allow calls to raw_hid_send() in the middle
     // of other endpoint usage.
-    uint8_t ep = Endpoint_GetCurrentEndpoint();
+    uint8_t ep      = Endpoint_GetCurrentEndpoint();
+    uint8_t timeout = 255;
 
     Endpoint_SelectEndpoint(RAW_IN_EPNUM);
 
-    // Check to see if the host is ready to accept another packet
+    // Check to see if the host is ready to accept another packet, waiting
+    // for a polling interval around 10ms so back to back packets are not dropped
+    while (timeout-- && !Endpoint_IsINReady()) _delay_us(40);
     if (Endpoint_IsINReady()) {
         // Write data
         Endpoint_Write_Stream_LE(data, RAW_EPSIZE, NULL);